@@ -7,6 +7,11 @@ public class GOAP : ModuleRules
 	public GOAP(ReadOnlyTargetRules Target) : base(Target)
 	{
 		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Feed the planning core's profiler marks to Unreal Insights. Defined for the module and its
+		// dependents rather than in a header, so every translation unit compiles the search the same way.
+		PublicDefinitions.Add("GOAPCORE_TRACE_INCLUDE=\"ProfilingDebugging/CpuProfilerTrace.h\"");
+		PublicDefinitions.Add("GOAPCORE_TRACE_SCOPE(Name)=TRACE_CPUPROFILER_EVENT_SCOPE(Name)");
 		
 		PublicIncludePaths.AddRange(
 			new string[] {
@@ -30,6 +35,7 @@ public class GOAP : ModuleRules
                 "Engine",
                 "AIModule",
 				"NavigationSystem",
+				"GOAPCore",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -42,6 +48,7 @@ public class GOAP : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"Json",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -6,6 +6,33 @@ UGOAPAction::UGOAPAction()
     Cost = 1.0f; // Default cost
 }
 
+void UGOAPAction::CompileFacts()
+{
+    const bool bPreconditionsComplete = GOAPPackFacts(Preconditions, PackedPreconditions);
+    const bool bEffectsComplete = GOAPPackFacts(Effects, PackedEffects);
+    bFactsComplete = bPreconditionsComplete && bEffectsComplete;
+    if (!bFactsComplete)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GOAP] Action %s uses facts beyond GOAP_MAX_FACTS, it will not be planned with."), *GetName());
+    }
+}
+
+void UGOAPAction::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    // Properties (including Blueprint defaults) are final here
+    CompileFacts();
+}
+
+#if WITH_EDITOR
+void UGOAPAction::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    CompileFacts();
+}
+#endif
+
 bool UGOAPAction::CanExecute_Implementation(const TMap<FName, bool>& WorldState) const
 {
     //GOAP_ACTION_LOG(nullptr, EGOAPDebugLevel::Minimal, "Checking action: %s", *GetName());
@@ -66,6 +66,7 @@ void UGOAPPatrolAction::Execute_Implementation(AGOAPAgent* Agent)
         *Agent->GetName(), *RandomLocation.Location.ToString());
 
     AICon->MoveToLocation(RandomLocation.Location);
+    NextRetargetTime = Agent->GetWorld()->GetTimeSeconds() + Agent->GetLODSettings().PatrolRetargetInterval;
 }
 
 void UGOAPPatrolAction::TickAction_Implementation(float DeltaTime, AGOAPAgent* Agent)
@@ -77,21 +78,16 @@ void UGOAPPatrolAction::TickAction_Implementation(float DeltaTime, AGOAPAgent* A
 
     EPathFollowingStatus::Type Status = AICon->GetMoveStatus();
 
-    // Decrease exhaustion gradually while patrolling
-    Agent->ExhaustionLimit -= Agent->ExhaustionDrainRate * DeltaTime;
+    // Decrease stamina gradually while patrolling, the channel sets IsExhausted once it is drained
+    UGOAPWorldStateComponent* WorldState = Agent->GetWorldState();
+    const int32 Stamina = Agent->GetStaminaChannelIndex();
+    WorldState->AddChannelValue(Stamina, -Agent->ExhaustionDrainRate * DeltaTime);
 
-    // Clamp to [0, 100]
-    Agent->ExhaustionLimit = FMath::Clamp(Agent->ExhaustionLimit, 0.f, 100.f);
-
-    // If exhausted update world state
-    if (Agent->ExhaustionLimit <= 0.f)
+    // If exhausted stop patrolling
+    if (Stamina != INDEX_NONE && WorldState->GetChannelValue(Stamina) <= 0.f)
     {
         GOAP_ACTION_LOG(Agent, EGOAPDebugLevel::Minimal, "%s is now exhausted!", *Agent->GetName());
 
-        // Update world state: mark exhausted and stop patrolling
-        Agent->GetWorldState()->Apply({
-            { "IsExhausted", true } });
-
         // Stop current movement
         if (AICon->GetMoveStatus() != EPathFollowingStatus::Idle)
         {
@@ -108,6 +104,13 @@ void UGOAPPatrolAction::TickAction_Implementation(float DeltaTime, AGOAPAgent* A
     // Check if reached destination
     if (Status == EPathFollowingStatus::Idle || Status == EPathFollowingStatus::Waiting)
     {
+        // Distant agents linger at each point instead of querying the navmesh again right away
+        const double Now = Agent->GetWorld()->GetTimeSeconds();
+        if (Now < NextRetargetTime)
+        {
+            return;
+        }
+
         GOAP_ACTION_LOG(Agent, EGOAPDebugLevel::Detailed, "PatrolAction: Reached destination  picking new patrol point.");
 
         UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(Agent->GetWorld());
@@ -122,6 +125,7 @@ void UGOAPPatrolAction::TickAction_Implementation(float DeltaTime, AGOAPAgent* A
                 *Agent->GetName(), *RandomLocation.Location.ToString());
 
             AICon->MoveToLocation(RandomLocation.Location);
+            NextRetargetTime = Now + Agent->GetLODSettings().PatrolRetargetInterval;
         }
     }
 }
@@ -31,13 +31,13 @@ void UGOAPRestAction::TickAction_Implementation(float DeltaTime, AGOAPAgent* Age
 {
     if (!bIsRunning || !Agent) return;
 
-    // Recharge stamina slowly
-    Agent->ExhaustionLimit += DeltaTime * 20.f;  // tune rate
+    // Recharge stamina slowly, the channel clears IsExhausted once it is full
+    UGOAPWorldStateComponent* WorldState = Agent->GetWorldState();
+    const int32 Stamina = Agent->GetStaminaChannelIndex();
+    WorldState->AddChannelValue(Stamina, DeltaTime * 20.f);  // tune rate
 
-    if (Agent->ExhaustionLimit >= 100.f) // full recovery
+    if (Stamina == INDEX_NONE || WorldState->GetChannelValue(Stamina) >= 100.f) // full recovery
     {
-        Agent->ExhaustionLimit = 100.f;
-
         GOAP_ACTION_LOG(Agent, EGOAPDebugLevel::Detailed, "%s finished resting. Fully recovered!", *Agent->GetName());
 
         Finish(Agent, true);
@@ -1,12 +1,16 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GOAP.h"
+#include "GOAPFactRegistry.h"
 
 #define LOCTEXT_NAMESPACE "FGOAPModule"
 
 void FGOAPModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// Intern the facts of all native actions and goals up front so they get dense, stable indices
+	FGOAPFactRegistry::Get().RegisterFactsFromLoadedClasses();
 }
 
 void FGOAPModule::ShutdownModule()
@@ -0,0 +1,48 @@
+#include "GOAPActionSet.h"
+#include "Actions/GOAPAction.h"
+
+void FGOAPActionSet::Build(const TArray<UGOAPAction*>& Actions)
+{
+    Init(Actions.Num());
+
+    for (int32 ActionIndex = 0; ActionIndex < Actions.Num(); ++ActionIndex)
+    {
+        // Null entries and actions with dropped facts stay invalid and are never planned with
+        const UGOAPAction* Action = Actions[ActionIndex];
+        if (Action && Action->HasCompleteFacts())
+        {
+            SetAction(ActionIndex, Action->GetPackedPreconditions(), Action->GetPackedEffects(), Action->Cost,
+                TCHAR_TO_UTF8(*Action->GetName()));
+        }
+    }
+
+    BuildIndices();
+}
+
+bool FGOAPActionSet::IsUpToDate(const TArray<UGOAPAction*>& Actions) const
+{
+    if (Actions.Num() != NumActions)
+    {
+        return false;
+    }
+
+    for (int32 ActionIndex = 0; ActionIndex < NumActions; ++ActionIndex)
+    {
+        const UGOAPAction* Action = Actions[ActionIndex];
+        const bool bValid = IsValidAction(ActionIndex);
+        if (!Action || !Action->HasCompleteFacts())
+        {
+            if (bValid) return false;
+            continue;
+        }
+
+        if (!bValid
+            || Costs[ActionIndex] != Action->Cost
+            || Preconditions[ActionIndex] != Action->GetPackedPreconditions()
+            || Effects[ActionIndex] != Action->GetPackedEffects())
+        {
+            return false;
+        }
+    }
+    return true;
+}
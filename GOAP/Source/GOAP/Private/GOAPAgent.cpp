@@ -2,9 +2,14 @@
 #include "Actions/GOAPAction.h"
 #include "Actions/PatrolAction.h"
 #include "AIController.h"
+#include "GOAPDomain.h"
+#include "GOAPLODSubsystem.h"
+#include "GOAPPlanCacheSubsystem.h"
+#include "GOAPReplanSubsystem.h"
+#include "GOAPStats.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/ScopeExit.h"
 #include "ProfilingDebugging/ScopedTimers.h"
-#include "ProfilingDebugging/CsvProfiler.h"
-#include "Stats/Stats.h"
 
 // Set up for categorizing debug information
 #define GOAP_LOG(Agent, Level, Format, ...) \
@@ -13,54 +18,93 @@
         UE_LOG(LogTemp, Warning, TEXT(Format), ##__VA_ARGS__); \
     }
 
-// Stat group "GOAP"
-DECLARE_STATS_GROUP(TEXT("GOAP"), STATGROUP_GOAP, STATCAT_Advanced);
-
-// Individual stats
-DECLARE_CYCLE_STAT(TEXT("GOAP Planner Tick"), STAT_GOAPPlannerTick, STATGROUP_GOAP);
-DECLARE_CYCLE_STAT(TEXT("GOAP Execute Goal"), STAT_GOAPExecureGoal, STATGROUP_GOAP);
-
 
 AGOAPAgent::AGOAPAgent()
 {
     // Attach the World State component
     WorldState = CreateDefaultSubobject<UGOAPWorldStateComponent>(TEXT("WorldState"));
+
+    // Stamina drains while patrolling and is restored by resting
+    FGOAPNumericChannel& Stamina = WorldState->NumericChannels.AddDefaulted_GetRef();
+    Stamina.Name = StaminaChannel;
+    Stamina.InitialValue = 100.f;
+    Stamina.MinValue = 0.f;
+    Stamina.MaxValue = 100.f;
+
+    FGOAPChannelThreshold& Exhausted = Stamina.Thresholds.AddDefaulted_GetRef();
+    Exhausted.Fact = "IsExhausted";
+    Exhausted.Threshold = 0.f;
+    Exhausted.bTrueBelow = true;
+    Exhausted.Hysteresis = 100.f;
 }
 
 void AGOAPAgent::BeginPlay()
 {
     Super::BeginPlay();
 
+    // Pre-warmed agents are pooled before play begins, Super::BeginPlay just enabled their ticks again
+    if (bInPool)
+    {
+        ApplyPooledState(true);
+    }
+
     if (!WorldState) return;
 
     WorldState->OwningAgent = this;
+    StaminaChannelIndex = WorldState->FindChannel(StaminaChannel);
+    if (StaminaChannelIndex == INDEX_NONE)
+    {
+        // The constructor names the default channel after the C++ default, follow an overridden StaminaChannel
+        StaminaChannelIndex = WorldState->FindChannel(GetDefault<AGOAPAgent>()->StaminaChannel);
+        if (StaminaChannelIndex != INDEX_NONE)
+        {
+            WorldState->NumericChannels[StaminaChannelIndex].Name = StaminaChannel;
+        }
+        else if (!StaminaChannel.IsNone())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[GOAP] %s: no numeric channel named %s, stamina will neither drain nor recover."),
+                *GetName(), *StaminaChannel.ToString());
+        }
+    }
 
     Planner = NewObject<UGOAPPlanner>(this);
+    Planner->MaxIterations = MaxPlanIterations;
     
     GOAP_LOG(this, EGOAPDebugLevel::Minimal, "Agent world state: %s", *WorldState->GetStateAsString());
 
     AvailableActions.Empty();
 
-    // Spawn actions from the class array
-    for (TSubclassOf<UGOAPAction> ActionClass : ActionClasses)
+    if (Domain)
     {
-        if (!ActionClass) continue;
-
-        UGOAPAction* NewAction = NewObject<UGOAPAction>(this, ActionClass);
-        AvailableActions.Add(NewAction);
+        // Share the domain's compiled actions and goals, actions are instantiated when first executed
+        DomainActions = Domain->GetActions();
+        AvailableActions.SetNumZeroed(DomainActions.Num());
+        AvailableGoals = Domain->GetGoals();
+        Planner->SetActionSet(Domain->GetActionSet());
     }
+    else
+    {
+        // Spawn actions from the class array
+        for (TSubclassOf<UGOAPAction> ActionClass : ActionClasses)
+        {
+            if (!ActionClass) continue;
 
-    GOAP_LOG(this, EGOAPDebugLevel::Minimal, "Available actions at runtime: %d", AvailableActions.Num());
+            UGOAPAction* NewAction = NewObject<UGOAPAction>(this, ActionClass);
+            AvailableActions.Add(NewAction);
+        }
 
-    // Spawn goals from the class array
-    for (TSubclassOf<UGOAPGoal> GoalClass : GoalClasses)
-    {
-        if (!GoalClass) continue;
+        // Spawn goals from the class array
+        for (TSubclassOf<UGOAPGoal> GoalClass : GoalClasses)
+        {
+            if (!GoalClass) continue;
 
-        UGOAPGoal* NewGoal = NewObject<UGOAPGoal>(this, GoalClass);
-        AvailableGoals.Add(NewGoal);
+            UGOAPGoal* NewGoal = NewObject<UGOAPGoal>(this, GoalClass);
+            AvailableGoals.Add(NewGoal);
+        }
     }
 
+    GOAP_LOG(this, EGOAPDebugLevel::Minimal, "Available actions at runtime: %d", GetPlanningActions().Num());
+
     GOAP_LOG(this, EGOAPDebugLevel::Minimal, "Available goals at runtime: %d", AvailableGoals.Num());
     for (UGOAPGoal* Goal : AvailableGoals)
     {
@@ -70,31 +114,177 @@ void AGOAPAgent::BeginPlay()
         }
     }
 
-    RequestReplan();
+    // Agents pre-warmed into a pool plan once they are acquired
+    if (!bInPool)
+    {
+        RequestReplan();
+    }
 
     if (WorldState)
     {
-        WorldState->OnWorldStateChanged.AddDynamic(this, &AGOAPAgent::RequestReplan);
+        WorldState->OnFactsChanged.AddUObject(this, &AGOAPAgent::OnWorldFactsChanged);
+    }
+
+    if (UGOAPLODSubsystem* LODSubsystem = bUseLOD && GetWorld() ? GetWorld()->GetSubsystem<UGOAPLODSubsystem>() : nullptr)
+    {
+        LODSubsystem->RegisterAgent(this);
+    }
+
+}
+
+void AGOAPAgent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    CancelPendingPlan();
+
+    if (UGOAPReplanSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UGOAPReplanSubsystem>() : nullptr)
+    {
+        Scheduler->CancelReplan(this);
+    }
+
+    if (UGOAPLODSubsystem* LODSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UGOAPLODSubsystem>() : nullptr)
+    {
+        LODSubsystem->UnregisterAgent(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AGOAPAgent::OnReleasedToPool()
+{
+    bInPool = true;
+
+    CancelPendingPlan();
+    StopCurrentPlan();
+    CurrentAction = nullptr;
+    bRequestReplan = false;
+
+    if (UGOAPReplanSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UGOAPReplanSubsystem>() : nullptr)
+    {
+        Scheduler->CancelReplan(this);
     }
 
+    if (AAIController* AICon = Cast<AAIController>(GetController()))
+    {
+        AICon->StopMovement();
+    }
+}
+
+void AGOAPAgent::OnAcquiredFromPool()
+{
+    bInPool = false;
+
+    // Start from the facts and channel values the agent was spawned with
+    if (WorldState)
+    {
+        WorldState->ResetState();
+    }
+
+    // The agent may come back far from where it was released
+    if (UGOAPLODSubsystem* LODSubsystem = bUseLOD && GetWorld() ? GetWorld()->GetSubsystem<UGOAPLODSubsystem>() : nullptr)
+    {
+        LODSubsystem->UpdateAgent(this);
+    }
+
+    RequestReplan();
+}
+
+void AGOAPAgent::ApplyPooledState(bool bPooled)
+{
+    SetActorHiddenInGame(bPooled);
+    SetActorEnableCollision(!bPooled);
+    SetActorTickEnabled(!bPooled);
+    if (UCharacterMovementComponent* Movement = GetCharacterMovement())
+    {
+        if (bPooled)
+        {
+            Movement->StopMovementImmediately();
+        }
+        Movement->SetComponentTickEnabled(!bPooled);
+    }
+}
+
+void AGOAPAgent::SetLOD(EGOAPLOD NewLOD, const FGOAPLODSettings& Settings)
+{
+    const EGOAPLOD OldLOD = LOD;
+    LOD = NewLOD;
+    LODSettings = Settings;
+
+    SetActorTickInterval(Settings.TickInterval);
+    if (Planner)
+    {
+        Planner->MaxIterations = FMath::Max(1, FMath::RoundToInt(MaxPlanIterations * Settings.PlanBudgetScale));
+        Planner->HeuristicWeight = Settings.HeuristicWeight;
+    }
+
+    GOAP_LOG(this, EGOAPDebugLevel::Detailed, "%s: LOD %s -> %s", *GetName(),
+        *UEnum::GetValueAsString(OldLOD), *UEnum::GetValueAsString(NewLOD));
+
+    if (NewLOD != EGOAPLOD::Dormant || OldLOD == EGOAPLOD::Dormant)
+    {
+        return;
+    }
+
+    // A dormant agent does not plan, give back the search and replan once woken up
+    UGOAPReplanSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UGOAPReplanSubsystem>() : nullptr;
+    if (IsPlanPending() || (Scheduler && Scheduler->IsQueued(this)))
+    {
+        CancelPendingPlan();
+        if (Scheduler)
+        {
+            Scheduler->CancelReplan(this);
+        }
+        bRequestReplan = true;
+        ReactionTimer = 0.f;
+    }
 }
 
 void AGOAPAgent::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    if (bInPool)
+    {
+        return;
+    }
+
     if (CurrentAction && CurrentAction->bIsRunning)
     {
+        TRACE_CPUPROFILER_EVENT_SCOPE(GOAPExecuteAction);
         CurrentAction->TickAction(DeltaTime, this);
     }
 
-    // Tick reaction timer for planning
-    if (bRequestReplan)
+    // Continue a time-sliced search within this frame's budget
+    if (bTimeSlicedPlanPending)
+    {
+        StepTimeSlicedPlan();
+    }
+
+    // Tick reaction timer for planning, dormant agents keep the request until they wake up
+    if (bRequestReplan && LOD != EGOAPLOD::Dormant)
     {
         ReactionTimer -= DeltaTime;
-        if (ReactionTimer <= 0.f)
+        if (ReactionTimer <= 0.f && bValidatePlanBeforeReplan && IsCurrentPlanValid())
         {
-            PlanActions();
+            // The change did not affect the plan, keep executing it and drop an earlier queued request
+            GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Current plan is still valid, skipping replan.");
+            bRequestReplan = false;
+            if (UGOAPReplanSubsystem* Scheduler = GetWorld() ? GetWorld()->GetSubsystem<UGOAPReplanSubsystem>() : nullptr)
+            {
+                Scheduler->CancelReplan(this);
+            }
+        }
+        else if (ReactionTimer <= 0.f)
+        {
+            // Let the world's scheduler fit the replan into its frame budget
+            UGOAPReplanSubsystem* Scheduler = bUseReplanScheduler && GetWorld() ? GetWorld()->GetSubsystem<UGOAPReplanSubsystem>() : nullptr;
+            if (Scheduler)
+            {
+                Scheduler->RequestReplan(this, GetReplanUrgency());
+            }
+            else
+            {
+                PlanActions();
+            }
             bRequestReplan = false;
         }
     }
@@ -113,40 +303,84 @@ void AGOAPAgent::ApplyEffects(const TMap<FName, bool>& Effects)
     }
 }
 
-void AGOAPAgent::RequestReplan()
+void AGOAPAgent::OnWorldFactsChanged(UGOAPWorldStateComponent* Component, const FGOAPPackedState& ChangedFacts)
 {
-    // Assign a random reaction time each replan
-    ReactionTimer = FMath::FRandRange(MinReactionTime, MaxReactionTime);
-    bRequestReplan = true;
+    if (bFilterIrrelevantFacts && !ChangedFacts.SharesFacts(GetRelevanceMask()))
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Detailed, "World state change ignored, no relevant fact changed.");
+        return;
+    }
+
+    RequestReplan();
 }
 
-void AGOAPAgent::PlanActions()
+FGOAPPackedState AGOAPAgent::GetRelevanceMask() const
 {
-    SCOPE_CYCLE_COUNTER(STAT_GOAPPlannerTick);
-    
-    if (!Planner || !WorldState)
+    // Without a plan any change may make one possible
+    if (CurrentPlan.Num() == 0 || !CurrentGoal)
     {
-        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: missing Planner or WorldState.");
-        return;
+        FGOAPPackedState All;
+        for (int32 W = 0; W < GOAP_FACT_WORDS; ++W)
+        {
+            All.Mask[W] = ~0ull;
+        }
+        return All;
     }
 
-    // step 1: stop any currently running actions before replanning
-    for (UGOAPAction* Action : AvailableActions)
+    // Facts that can change which goal is selected, what the goal needs and whether the plan still runs
+    FGOAPPackedState Relevant;
+    for (const UGOAPGoal* Goal : AvailableGoals)
     {
-        if (Action && Action->bIsRunning)
+        if (Goal)
         {
-            GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Stopping current action: %s", *Action->GetName());
-            Action->OnInterrupt(this);
+            Relevant.AddFacts(Goal->GetRelevanceMask());
         }
     }
 
-    CurrentPlan.Empty();
+    Relevant.AddFacts(CurrentGoal->GetPackedDesiredState());
+
+    for (const UGOAPAction* Action : CurrentPlan)
+    {
+        if (Action)
+        {
+            Relevant.AddFacts(Action->GetPackedPreconditions());
+        }
+    }
+    return Relevant;
+}
+
+void AGOAPAgent::RequestReplan()
+{
+    // Assign a random reaction time each replan
+    ReactionTimer = FMath::FRandRange(MinReactionTime, MaxReactionTime) * LODSettings.ReactionTimeScale;
+    bRequestReplan = true;
+}
 
-    // step 2: sort all goals by priority (descending)
-    AvailableGoals.Sort([](const UGOAPGoal& A, const UGOAPGoal& B)
+EGOAPUrgency AGOAPAgent::GetReplanUrgency() const
+{
+    // The most urgent goal that could be picked decides how long the replan may wait
+    EGOAPUrgency Urgency = EGOAPUrgency::Low;
+    for (const UGOAPGoal* Goal : AvailableGoals)
+    {
+        if (Goal && Goal->Urgency > Urgency && WorldState && Goal->IsRelevantFast(WorldState->GetPackedState(), WorldState->CurrentState))
         {
-            return A.Priority > B.Priority; // higher = more important
-        });
+            Urgency = Goal->Urgency;
+        }
+    }
+    return Urgency;
+}
+
+UGOAPGoal* AGOAPAgent::SelectGoal()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(GOAPSelectGoal);
+
+    if (!WorldState)
+    {
+        return nullptr;
+    }
+
+    // step 2: keep goals sorted by priority (descending)
+    SortGoalsIfNeeded();
 
     // step 3: pick the first goal that is relevant
     UGOAPGoal* BestGoal = nullptr;
@@ -155,7 +389,7 @@ void AGOAPAgent::PlanActions()
     {
         if (!Goal) continue;
 
-        bool bRelevant = Goal->IsRelevant(WorldState->CurrentState);
+        bool bRelevant = Goal->IsRelevantFast(WorldState->GetPackedState(), WorldState->CurrentState);
 
         GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Evaluating Goal: %s | Priority: %.1f | Relevant: %s",
             *Goal->GetGoalName(), Goal->Priority, bRelevant ? TEXT("true") : TEXT("false"));
@@ -168,43 +402,587 @@ void AGOAPAgent::PlanActions()
     }
 
     // step 4: fallback  if none are relevant, pick the lowest priority goal
-    if (!BestGoal && AvailableGoals.Num() > 0)
+    // whose facts all fit into the registry
+    for (int32 Index = AvailableGoals.Num() - 1; !BestGoal && Index >= 0; --Index)
     {
-        BestGoal = AvailableGoals.Last();
-        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "[Agent] No relevant goals found  using fallback: %s", *BestGoal->GetGoalName());
+        UGOAPGoal* Goal = AvailableGoals[Index];
+        if (Goal && Goal->HasCompleteFacts())
+        {
+            BestGoal = Goal;
+            GOAP_LOG(this, EGOAPDebugLevel::Minimal, "[Agent] No relevant goals found  using fallback: %s", *BestGoal->GetGoalName());
+        }
+    }
+
+    return BestGoal;
+}
+
+void AGOAPAgent::SortGoalsIfNeeded()
+{
+    // A linear check is all it takes while priorities stay the same
+    for (int32 i = 1; i < AvailableGoals.Num(); ++i)
+    {
+        const UGOAPGoal* Prev = AvailableGoals[i - 1];
+        const UGOAPGoal* Goal = AvailableGoals[i];
+        if (!Prev || !Goal || Prev->Priority < Goal->Priority)
+        {
+            AvailableGoals.RemoveAll([](const UGOAPGoal* G) { return G == nullptr; });
+            AvailableGoals.Sort([](const UGOAPGoal& A, const UGOAPGoal& B)
+                {
+                    return A.Priority > B.Priority; // higher = more important
+                });
+            return;
+        }
     }
+}
+
+bool AGOAPAgent::IsCurrentPlanValid()
+{
+    if (!WorldState || !CurrentGoal || CurrentPlan.Num() == 0 || IsPlanPending())
+    {
+        return false;
+    }
+
+    // The remaining actions, the running one included, must still chain from the new state to the goal
+    FGOAPPackedState State = WorldState->GetPackedState();
+    for (const UGOAPAction* Action : CurrentPlan)
+    {
+        if (!Action) continue;
+
+        if (!State.Satisfies(Action->GetPackedPreconditions()))
+        {
+            GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Plan invalid: preconditions of %s no longer hold.", *Action->GetName());
+            return false;
+        }
+        State.Apply(Action->GetPackedEffects());
+    }
+
+    if (!State.Satisfies(CurrentGoal->GetPackedDesiredState()))
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Plan invalid: no longer reaches %s.", *CurrentGoal->GetGoalName());
+        return false;
+    }
+
+    if (bPlanMultiGoal)
+    {
+        // The search may have passed over goals it could not reach, only a goal above the
+        // current one that became relevant since, or a current goal that lost relevance, calls for a new search
+        SortGoalsIfNeeded();
+        bool bAnyRelevant = false;
+        bool bAboveCurrent = true;
+        for (UGOAPGoal* Goal : AvailableGoals)
+        {
+            if (!Goal) continue;
+
+            if (Goal == CurrentGoal)
+            {
+                bAboveCurrent = false;
+            }
+
+            const bool bRelevant = Goal->IsRelevantFast(WorldState->GetPackedState(), WorldState->CurrentState);
+            bAnyRelevant |= bRelevant;
+            if (bRelevant && bAboveCurrent && !SkippedGoals.Contains(Goal))
+            {
+                GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Plan invalid: %s became relevant.", *Goal->GetGoalName());
+                return false;
+            }
+        }
+
+        if (bAnyRelevant && !CurrentGoal->IsRelevantFast(WorldState->GetPackedState(), WorldState->CurrentState))
+        {
+            GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Plan invalid: %s is no longer relevant.", *CurrentGoal->GetGoalName());
+            return false;
+        }
+        return true;
+    }
+
+    // Goal selection must still end on the same goal, no more important goal became relevant
+    if (SelectGoal() != CurrentGoal)
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Plan invalid: %s is no longer the selected goal.", *CurrentGoal->GetGoalName());
+        return false;
+    }
+
+    return true;
+}
+
+void AGOAPAgent::PlanActions()
+{
+    SCOPE_CYCLE_COUNTER(STAT_GOAPPlannerTick);
+    TRACE_CPUPROFILER_EVENT_SCOPE(GOAPPlanActions);
+    CSV_SCOPED_TIMING_STAT(GOAP, PlanActions);
+
+    const double PlanStartTime = FPlatformTime::Seconds();
+    ON_SCOPE_EXIT
+    {
+        LastPlanMicroseconds = (FPlatformTime::Seconds() - PlanStartTime) * 1e6;
+        ++NumPlanCalls;
+    };
+    
+    if (!Planner || !WorldState)
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: missing Planner or WorldState.");
+        return;
+    }
+
+    // step 1: a newer replan supersedes any search still running
+    CancelPendingPlan();
+
+    if (bPlanMultiGoal)
+    {
+        PlanMultiGoal();
+        return;
+    }
+
+    // step 2 - 4: pick the most important relevant goal
+    UGOAPGoal* BestGoal = SelectGoal();
 
     if (!BestGoal)
     {
         GOAP_LOG(this, EGOAPDebugLevel::Minimal, "[Agent] No goals available at all.");
+        StopCurrentPlan();
         return;
     }
 
     GOAP_LOG(this, EGOAPDebugLevel::Minimal, "[Agent] Selected goal: %s (Priority %.1f)",
         *BestGoal->GetGoalName(), BestGoal->Priority);
 
-    // step 5: run the planner for that goal
-    TArray<UGOAPAction*> PlannedActions;
-    bool bFoundPlan = Planner->Plan(WorldState->CurrentState, BestGoal->DesiredState, AvailableActions, PlannedActions, DebugLevel);
+    // step 5: run the planner for that goal, in the direction the goal asks for
+    const EGOAPSearchMode GoalSearchMode = BestGoal->SearchMode != EGOAPSearchMode::Default ? BestGoal->SearchMode : SearchMode;
+
+    // Agents sharing an action set share plans, look for one before searching
+    UGOAPPlanCacheSubsystem* PlanCache = nullptr;
+    if (bUsePlanCache && GetWorld())
+    {
+        PlanCache = GetWorld()->GetSubsystem<UGOAPPlanCacheSubsystem>();
+    }
+
+    FGOAPPlanCacheKey CacheKey;
+    CacheKey.Start = WorldState->GetPackedState();
+    CacheKey.Goal = BestGoal->GetPackedDesiredState();
+    CacheKey.SearchMode = GoalSearchMode;
+    CacheKey.Heuristic = PlanHeuristic;
+    CacheKey.HeuristicWeight = Planner->HeuristicWeight;
+
+    TArray<int32> PlannedIndices;
+    bool bFoundPlan = false;
+    bool bCacheHit = false;
+
+    if (PlanCache)
+    {
+        CacheKey.ActionSetSignature = Planner->GetActionSet(GetPlanningActions()).Signature;
+        bCacheHit = PlanCache->Find(CacheKey, PlannedIndices, bFoundPlan);
+
+        GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Plan cache %s for goal: %s", bCacheHit ? TEXT("hit") : TEXT("miss"), *BestGoal->GetGoalName());
+    }
+
+    if (!bCacheHit)
+    {
+        // Search on a worker, the current action keeps running until the result is in
+        if (bPlanAsync)
+        {
+            GOAP_LOG(this, EGOAPDebugLevel::Detailed, "PlanActions: Planning asynchronously for goal: %s", *BestGoal->GetGoalName());
+
+            PendingPlanGoal = BestGoal;
+            PendingPlanRequest = Planner->PlanAsync(CacheKey.Start, CacheKey.Goal, GetPlanningActions(),
+                FGOAPOnAsyncPlanComplete::CreateUObject(this, &AGOAPAgent::OnAsyncPlanComplete), DebugLevel, GoalSearchMode, PlanHeuristic);
+            return;
+        }
+
+        // Spread the search over frames, the current action keeps running until it finishes
+        if (bTimeSlicePlanning)
+        {
+            PendingPlanGoal = BestGoal;
+            if (bPlanAnytime)
+            {
+                Planner->BeginPlanAnytime(CacheKey.Start, CacheKey.Goal, GetPlanningActions(), AnytimeInitialWeight, DebugLevel, GoalSearchMode, PlanHeuristic);
+            }
+            else
+            {
+                Planner->BeginPlan(CacheKey.Start, CacheKey.Goal, GetPlanningActions(), DebugLevel, GoalSearchMode, PlanHeuristic);
+            }
+            bTimeSlicedPlanPending = true;
+            StepTimeSlicedPlan();
+            return;
+        }
+
+        EGOAPSearchFailure Failure = EGOAPSearchFailure::None;
+        bFoundPlan = Planner->PlanIndices(CacheKey.Start, CacheKey.Goal, GetPlanningActions(), PlannedIndices, DebugLevel, GoalSearchMode, PlanHeuristic, &Failure);
+
+        if (PlanCache)
+        {
+            PlanCache->AddSearchResult(CacheKey, PlannedIndices, bFoundPlan, Failure);
+        }
+    }
+
+    // step 6: execute the plan
+    StartPlan(PlannedIndices, bFoundPlan, BestGoal);
+}
+
+void AGOAPAgent::PlanMultiGoal()
+{
+    // Candidates in priority order: the relevant goals, or every goal if none is relevant
+    SortGoalsIfNeeded();
+    TArray<UGOAPGoal*> Candidates;
+    for (UGOAPGoal* Goal : AvailableGoals)
+    {
+        if (!Goal) continue;
+
+        if (Goal->IsRelevantFast(WorldState->GetPackedState(), WorldState->CurrentState))
+        {
+            Candidates.Add(Goal);
+        }
+    }
+    if (Candidates.Num() == 0)
+    {
+        for (UGOAPGoal* Goal : AvailableGoals)
+        {
+            if (Goal && Goal->HasCompleteFacts())
+            {
+                Candidates.Add(Goal);
+            }
+        }
+    }
+
+    if (Candidates.Num() == 0)
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "[Agent] No goals available at all.");
+        StopCurrentPlan();
+        return;
+    }
+
+    TArray<FGOAPGoalCandidate> GoalStates;
+    GoalStates.Reserve(Candidates.Num());
+    for (const UGOAPGoal* Goal : Candidates)
+    {
+        GoalStates.Add(FGOAPGoalCandidate{ Goal->GetPackedDesiredState(), Goal->Priority });
+    }
+
+    GOAP_LOG(this, EGOAPDebugLevel::Minimal, "[Agent] Planning for %d candidate goals.", Candidates.Num());
+
+    const FGOAPPackedState& Start = WorldState->GetPackedState();
+
+    // The utility bound needs an admissible estimate, and Relaxed Max drops unreachable goals
+    // before the search spends its iterations on them
+    const EGOAPHeuristic Heuristic = EGOAPHeuristic::Max;
+
+    if (bPlanAsync)
+    {
+        PendingGoalCandidates.Append(Candidates);
+        PendingPlanRequest = Planner->PlanMultiGoalAsync(Start, GoalStates, GetPlanningActions(),
+            FGOAPOnAsyncPlanComplete::CreateUObject(this, &AGOAPAgent::OnAsyncPlanComplete), PlanCostWeight, DebugLevel, Heuristic);
+        return;
+    }
+
+    if (bTimeSlicePlanning)
+    {
+        PendingGoalCandidates.Append(Candidates);
+        Planner->BeginPlanMultiGoal(Start, GoalStates, GetPlanningActions(), PlanCostWeight, DebugLevel, Heuristic);
+        bTimeSlicedPlanPending = true;
+        StepTimeSlicedPlan();
+        return;
+    }
+
+    TArray<int32> PlannedIndices;
+    int32 GoalIndex = INDEX_NONE;
+    const bool bFoundPlan = Planner->PlanMultiGoal(Start, GoalStates, GetPlanningActions(), PlannedIndices, GoalIndex, PlanCostWeight, DebugLevel, Heuristic);
+
+    StartMultiGoalPlan(Candidates, GoalIndex, PlannedIndices, bFoundPlan);
+}
+
+void AGOAPAgent::StartMultiGoalPlan(const TArray<UGOAPGoal*>& Candidates, int32 GoalIndex, const TArray<int32>& ActionIndices, bool bFoundPlan)
+{
+    if (!bFoundPlan || !Candidates.IsValidIndex(GoalIndex))
+    {
+        // Nothing reachable, report it against the most important candidate
+        StartPlan(ActionIndices, false, Candidates[0]);
+        return;
+    }
+
+    StartPlan(ActionIndices, true, Candidates[GoalIndex]);
+
+    SkippedGoals.Reset();
+    SkippedGoals.Append(Candidates.GetData(), GoalIndex);
+}
+
+void AGOAPAgent::OnAsyncPlanComplete(const FGOAPAsyncPlanRequestRef& Request)
+{
+    if (PendingPlanRequest.Get() != &Request.Get())
+    {
+        return; // superseded by a newer request
+    }
+
+    PendingPlanRequest.Reset();
+
+    AcceptDeferredPlan(*Request->ActionSet, Request->Current, Request->Goal, Request->SearchMode, Request->Heuristic, Request->HeuristicWeight,
+        Request->ActionIndices, Request->bFoundPlan, Request->Failure, Request->GoalIndex);
+}
+
+void AGOAPAgent::StepTimeSlicedPlan()
+{
+    if (!Planner)
+    {
+        bTimeSlicedPlanPending = false;
+        return;
+    }
+
+    const FGOAPPlanSearch& Search = Planner->GetSearch();
+    if (Search.IsAnytime())
+    {
+        StepAnytimePlan();
+        return;
+    }
+
+    const EGOAPSearchStatus Status = StepPlanSlice();
+    if (Status == EGOAPSearchStatus::InProgress)
+    {
+        return;
+    }
+
+    bTimeSlicedPlanPending = false;
+
+    GOAP_LOG(this, EGOAPDebugLevel::Detailed, "PlanActions: Time-sliced search finished after %d iterations.", Search.GetNumIterations());
+
+    // Weighted searches are anytime searches and never get here, this one was unweighted
+    if (Search.GetActionSet().IsValid())
+    {
+        AcceptDeferredPlan(*Search.GetActionSet(), Search.GetCurrent(), Search.GetGoal(), Search.GetSearchMode(), Search.GetHeuristic(), 1.f,
+            Search.GetPlan(), Status == EGOAPSearchStatus::Succeeded, Search.GetStats().Failure, Search.GetGoalIndex());
+    }
+}
+
+EGOAPSearchStatus AGOAPAgent::StepPlanSlice()
+{
+    const int32 MaxExpansions = FMath::Max(1, FMath::RoundToInt(PlanExpansionsPerTick * LODSettings.PlanBudgetScale));
+    return Planner->StepPlan(MaxExpansions, PlanMicrosecondsPerTick * LODSettings.PlanBudgetScale);
+}
+
+void AGOAPAgent::StepAnytimePlan()
+{
+    // Once the first action is done the agent is committed, refining further is wasted
+    if (AnytimePlansAccepted > 0 && CurrentPlan.Num() < AnytimePlanLength)
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Detailed, "PlanActions: First action finished, anytime search stopped.");
+        CancelPendingPlan();
+        return;
+    }
+
+    const FGOAPPlanSearch& Search = Planner->GetSearch();
+    const EGOAPSearchStatus Status = StepPlanSlice();
+
+    if (Search.GetNumSolutions() > AnytimePlansAccepted)
+    {
+        AcceptAnytimePlan(Search);
+        if (!bTimeSlicedPlanPending)
+        {
+            return; // the plan was outdated and the search cancelled
+        }
+    }
+
+    if (Status == EGOAPSearchStatus::InProgress || Status == EGOAPSearchStatus::Improving)
+    {
+        return;
+    }
+
+    GOAP_LOG(this, EGOAPDebugLevel::Detailed, "PlanActions: Anytime search finished after %d iterations, %d plans (Bound=%.2f).",
+        Search.GetNumIterations(), Search.GetNumSolutions(), Search.GetSuboptimalityBound());
+
+    UGOAPGoal* Goal = PendingPlanGoal.Get();
+    const bool bAnyAccepted = AnytimePlansAccepted > 0;
+    CancelPendingPlan();
+
+    if (!bAnyAccepted && Goal)
+    {
+        StartPlan(TArray<int32>(), false, Goal);
+    }
+}
+
+void AGOAPAgent::AcceptAnytimePlan(const FGOAPPlanSearch& Search)
+{
+    const bool bFirstPlan = AnytimePlansAccepted == 0;
+    AnytimePlansAccepted = Search.GetNumSolutions();
+
+    UGOAPGoal* Goal = PendingPlanGoal.Get();
+    const FGOAPActionSet& PlannedSet = *Search.GetActionSet();
+    const TArray<int32>& ActionIndices = Search.GetPlan();
+
+    // Later plans only replace the one they refine, not a plan the agent switched to since
+    if (!bFirstPlan && CurrentGoal != Goal)
+    {
+        CancelPendingPlan();
+        return;
+    }
+
+    const bool bStillValid = Goal && WorldState
+        && Planner->GetActionSet(GetPlanningActions()).Signature == PlannedSet.Signature
+        && PlannedSet.IsPlanValid(WorldState->GetPackedState(), Search.GetGoal(), ActionIndices);
+    if (!bStillValid)
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: Anytime plan is outdated, replanning.");
+        CancelPendingPlan();
+        RequestReplan();
+        return;
+    }
+
+    AnytimePlanLength = ActionIndices.Num();
+
+    // Keep the running action if the better plan starts with it as well
+    if (!bFirstPlan && ActionIndices.Num() > 0 && CurrentAction && CurrentAction->bIsRunning
+        && GetActionInstance(ActionIndices[0]) == CurrentAction)
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: Anytime plan improved to %d steps (Bound=%.2f).",
+            ActionIndices.Num(), Search.GetSuboptimalityBound());
+
+        CurrentPlan.Reset();
+        for (int32 ActionIndex : ActionIndices)
+        {
+            CurrentPlan.Add(GetActionInstance(ActionIndex));
+        }
+        return;
+    }
+
+    StartPlan(ActionIndices, true, Goal);
+}
+
+void AGOAPAgent::AcceptDeferredPlan(const FGOAPActionSet& PlannedSet, const FGOAPPackedState& PlannedStart, const FGOAPPackedState& PlannedGoal,
+    EGOAPSearchMode PlannedSearchMode, EGOAPHeuristic PlannedHeuristic, float PlannedHeuristicWeight, const TArray<int32>& ActionIndices, bool bFoundPlan,
+    EGOAPSearchFailure Failure, int32 PlannedGoalIndex)
+{
+    UGOAPGoal* Goal = PendingPlanGoal.Get();
+    PendingPlanGoal.Reset();
+
+    // A multi-goal search only tells which candidate it reached once it is done
+    TArray<UGOAPGoal*> Candidates;
+    for (const TWeakObjectPtr<UGOAPGoal>& Candidate : PendingGoalCandidates)
+    {
+        Candidates.Add(Candidate.Get());
+    }
+    PendingGoalCandidates.Reset();
+
+    const bool bMultiGoal = Candidates.Num() > 0;
+    if (bMultiGoal)
+    {
+        Goal = Candidates.IsValidIndex(PlannedGoalIndex) ? Candidates[PlannedGoalIndex] : Candidates[0];
+    }
+
+    if (!Planner || !WorldState || !Goal || Candidates.Contains(nullptr))
+    {
+        return;
+    }
+
+    // The world and the actions may have moved on while the search was running
+    const FGOAPPackedState& Current = WorldState->GetPackedState();
+    const bool bSameActions = Planner->GetActionSet(GetPlanningActions()).Signature == PlannedSet.Signature;
+    const bool bStillValid = bSameActions && (bFoundPlan
+        ? PlannedSet.IsPlanValid(Current, PlannedGoal, ActionIndices)
+        : Current == PlannedStart);
+
+    if (!bStillValid)
+    {
+        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: Deferred plan for goal %s is outdated, replanning.", *Goal->GetGoalName());
+        RequestReplan();
+        return;
+    }
+
+    if (bMultiGoal)
+    {
+        StartMultiGoalPlan(Candidates, PlannedGoalIndex, ActionIndices, bFoundPlan);
+        return;
+    }
+
+    // The result is exact for the snapshot it was searched from
+    if (bUsePlanCache && GetWorld())
+    {
+        if (UGOAPPlanCacheSubsystem* PlanCache = GetWorld()->GetSubsystem<UGOAPPlanCacheSubsystem>())
+        {
+            FGOAPPlanCacheKey CacheKey;
+            CacheKey.Start = PlannedStart;
+            CacheKey.Goal = PlannedGoal;
+            CacheKey.ActionSetSignature = PlannedSet.Signature;
+            CacheKey.SearchMode = PlannedSearchMode;
+            CacheKey.Heuristic = PlannedHeuristic;
+            CacheKey.HeuristicWeight = PlannedHeuristicWeight;
+            PlanCache->AddSearchResult(CacheKey, ActionIndices, bFoundPlan, Failure);
+        }
+    }
+
+    StartPlan(ActionIndices, bFoundPlan, Goal);
+}
+
+void AGOAPAgent::CancelPendingPlan()
+{
+    if (PendingPlanRequest.IsValid())
+    {
+        PendingPlanRequest->Cancel();
+        PendingPlanRequest.Reset();
+    }
+
+    if (bTimeSlicedPlanPending && Planner)
+    {
+        Planner->CancelPlan();
+    }
+    bTimeSlicedPlanPending = false;
+    AnytimePlansAccepted = 0;
+    AnytimePlanLength = 0;
+
+    PendingPlanGoal.Reset();
+    PendingGoalCandidates.Reset();
+}
+
+UGOAPAction* AGOAPAgent::GetActionInstance(int32 ActionIndex)
+{
+    if (!AvailableActions.IsValidIndex(ActionIndex))
+    {
+        return nullptr;
+    }
+
+    UGOAPAction*& Action = AvailableActions[ActionIndex];
+    if (!Action && Domain)
+    {
+        Action = Domain->CreateAction(ActionIndex, this);
+    }
+    return Action;
+}
+
+void AGOAPAgent::StopCurrentPlan()
+{
+    // Stop any currently running actions before switching plans
+    for (UGOAPAction* Action : AvailableActions)
+    {
+        if (Action && Action->bIsRunning)
+        {
+            GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Stopping current action: %s", *Action->GetName());
+            Action->OnInterrupt(this);
+        }
+    }
+
+    CurrentPlan.Empty();
+    CurrentGoal = nullptr;
+    SkippedGoals.Reset();
+}
+
+void AGOAPAgent::StartPlan(const TArray<int32>& ActionIndices, bool bFoundPlan, UGOAPGoal* Goal)
+{
+    StopCurrentPlan();
+    CurrentGoal = Goal;
 
     if (bFoundPlan)
     {
-        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: Found plan with %d steps.", PlannedActions.Num());
-        for (int32 StepIndex = 0; StepIndex < PlannedActions.Num(); ++StepIndex)
+        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: Found plan with %d steps.", ActionIndices.Num());
+        for (int32 StepIndex = 0; StepIndex < ActionIndices.Num(); ++StepIndex)
         {
-            if (PlannedActions[StepIndex])
+            UGOAPAction* Action = GetActionInstance(ActionIndices[StepIndex]);
+            if (Action)
             {
-                GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Step %d: %s", StepIndex, *PlannedActions[StepIndex]->GetName());
+                GOAP_LOG(this, EGOAPDebugLevel::Detailed, "Step %d: %s", StepIndex, *Action->GetName());
             }
+            CurrentPlan.Add(Action);
         }
-        CurrentPlan = PlannedActions;
     }
     else
     {
-        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: No valid plan found for goal: %s", *BestGoal->GetGoalName());
+        GOAP_LOG(this, EGOAPDebugLevel::Minimal, "PlanActions: No valid plan found for goal: %s", *Goal->GetGoalName());
     }
 
-    // step 6: execute the plan
     if (CurrentPlan.Num() > 0)
     {
         ExecutePlan();
@@ -215,6 +993,8 @@ void AGOAPAgent::PlanActions()
 void AGOAPAgent::ExecutePlan()
 {
     SCOPE_CYCLE_COUNTER(STAT_GOAPExecureGoal);
+    TRACE_CPUPROFILER_EVENT_SCOPE(GOAPExecutePlan);
+    CSV_SCOPED_TIMING_STAT(GOAP, ExecutePlan);
 
     if (CurrentPlan.Num() == 0)
     {
@@ -0,0 +1,112 @@
+#include "GOAPAgentPoolSubsystem.h"
+#include "GOAPAgent.h"
+
+AGOAPAgent* UGOAPAgentPoolSubsystem::AcquireAgent(TSubclassOf<AGOAPAgent> AgentClass, const FTransform& Transform)
+{
+    if (!AgentClass)
+    {
+        return nullptr;
+    }
+
+    // Agents destroyed while pooled leave null entries behind
+    AGOAPAgent* Agent = nullptr;
+    if (FGOAPAgentPool* Pool = Pools.Find(AgentClass))
+    {
+        while (!Agent && Pool->Agents.Num() > 0)
+        {
+            Agent = Pool->Agents.Pop();
+            if (!IsValid(Agent))
+            {
+                Agent = nullptr;
+            }
+        }
+    }
+
+    if (!Agent)
+    {
+        return SpawnAgent(AgentClass, Transform);
+    }
+
+    Agent->SetActorTransform(Transform, /*bSweep*/ false, nullptr, ETeleportType::TeleportPhysics);
+    Agent->ApplyPooledState(false);
+
+    Agent->OnAcquiredFromPool();
+    return Agent;
+}
+
+void UGOAPAgentPoolSubsystem::ReleaseAgent(AGOAPAgent* Agent)
+{
+    if (!IsValid(Agent) || Agent->IsInPool())
+    {
+        return;
+    }
+
+    Agent->OnReleasedToPool();
+    Agent->ApplyPooledState(true);
+
+    Pools.FindOrAdd(Agent->GetClass()).Agents.Add(Agent);
+}
+
+void UGOAPAgentPoolSubsystem::PrewarmAgents(TSubclassOf<AGOAPAgent> AgentClass, int32 Count)
+{
+    if (!AgentClass)
+    {
+        return;
+    }
+
+    FGOAPAgentPool& Pool = Pools.FindOrAdd(AgentClass);
+    Pool.Agents.Reserve(Count);
+
+    const int32 NumToSpawn = Count - Pool.Agents.Num();
+    for (int32 Index = 0; Index < NumToSpawn; ++Index)
+    {
+        ReleaseAgent(SpawnAgent(AgentClass, FTransform::Identity));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[GOAP] Agent pool: %d %s ready."), Pools.FindChecked(AgentClass).Agents.Num(), *AgentClass->GetName());
+}
+
+int32 UGOAPAgentPoolSubsystem::GetNumPooled(TSubclassOf<AGOAPAgent> AgentClass) const
+{
+    const FGOAPAgentPool* Pool = Pools.Find(AgentClass);
+    return Pool ? Pool->Agents.Num() : 0;
+}
+
+AGOAPAgent* UGOAPAgentPoolSubsystem::SpawnAgent(TSubclassOf<AGOAPAgent> AgentClass, const FTransform& Transform)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    FActorSpawnParameters Params;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    return World->SpawnActor<AGOAPAgent>(AgentClass, Transform, Params);
+}
+
+void UGOAPAgentPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Pay for the configured agents while the level loads rather than during play
+    for (const FGOAPAgentPrewarm& Entry : Prewarm)
+    {
+        if (UClass* AgentClass = Entry.AgentClass.LoadSynchronous())
+        {
+            PrewarmAgents(AgentClass, Entry.Count);
+        }
+    }
+}
+
+void UGOAPAgentPoolSubsystem::Deinitialize()
+{
+    Pools.Reset();
+
+    Super::Deinitialize();
+}
+
+bool UGOAPAgentPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
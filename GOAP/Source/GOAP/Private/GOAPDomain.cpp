@@ -0,0 +1,81 @@
+#include "GOAPDomain.h"
+#include "Actions/GOAPAction.h"
+#include "Goals/GOAPGoal.h"
+
+const TArray<UGOAPAction*>& UGOAPDomain::GetActions()
+{
+    CompileIfNeeded();
+    return ActionDefaults;
+}
+
+const TArray<UGOAPGoal*>& UGOAPDomain::GetGoals()
+{
+    CompileIfNeeded();
+    return GoalDefaults;
+}
+
+TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe> UGOAPDomain::GetActionSet()
+{
+    CompileIfNeeded();
+    return ActionSet.ToSharedRef();
+}
+
+UGOAPAction* UGOAPDomain::CreateAction(int32 ActionIndex, UObject* Outer) const
+{
+    if (!ActionClasses.IsValidIndex(ActionIndex) || !ActionClasses[ActionIndex])
+    {
+        return nullptr;
+    }
+    return NewObject<UGOAPAction>(Outer, ActionClasses[ActionIndex]);
+}
+
+void UGOAPDomain::CompileIfNeeded()
+{
+    if (!ActionSet.IsValid())
+    {
+        Compile();
+    }
+}
+
+void UGOAPDomain::Compile()
+{
+    ActionDefaults.Reset();
+    for (TSubclassOf<UGOAPAction> ActionClass : ActionClasses)
+    {
+        UGOAPAction* Action = ActionClass ? ActionClass->GetDefaultObject<UGOAPAction>() : nullptr;
+        if (Action)
+        {
+            // Blueprint defaults may have been loaded after the defaults were constructed
+            Action->CompileFacts();
+        }
+        ActionDefaults.Add(Action);
+    }
+
+    GoalDefaults.Reset();
+    for (TSubclassOf<UGOAPGoal> GoalClass : GoalClasses)
+    {
+        if (UGOAPGoal* Goal = GoalClass ? GoalClass->GetDefaultObject<UGOAPGoal>() : nullptr)
+        {
+            Goal->CompileFacts();
+            GoalDefaults.Add(Goal);
+        }
+    }
+
+    TSharedRef<FGOAPActionSet, ESPMode::ThreadSafe> NewSet = MakeShared<FGOAPActionSet, ESPMode::ThreadSafe>();
+    NewSet->Build(ActionDefaults);
+    ActionSet = NewSet;
+}
+
+void UGOAPDomain::PostLoad()
+{
+    Super::PostLoad();
+    ActionSet.Reset();
+}
+
+#if WITH_EDITOR
+void UGOAPDomain::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    ActionSet.Reset();
+}
+#endif
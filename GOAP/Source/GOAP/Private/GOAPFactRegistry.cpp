@@ -0,0 +1,94 @@
+#include "GOAPFactRegistry.h"
+#include "Actions/GOAPAction.h"
+#include "Goals/GOAPGoal.h"
+#include "UObject/UObjectIterator.h"
+
+FGOAPFactRegistry& FGOAPFactRegistry::Get()
+{
+    static FGOAPFactRegistry Registry;
+    return Registry;
+}
+
+int32 FGOAPFactRegistry::FindOrAddFact(FName Fact)
+{
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (const int32* Found = FactToIndex.Find(Fact))
+        {
+            return *Found;
+        }
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+
+    // Another thread may have added it between the two locks
+    if (const int32* Found = FactToIndex.Find(Fact))
+    {
+        return *Found;
+    }
+
+    if (IndexToFact.Num() >= GOAP_MAX_FACTS)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GOAP] Fact registry is full (%d facts), ignoring fact %s. Raise GOAP_MAX_FACTS."),
+            GOAP_MAX_FACTS, *Fact.ToString());
+        return INDEX_NONE;
+    }
+
+    const int32 Index = IndexToFact.Add(Fact);
+    FactToIndex.Add(Fact, Index);
+    return Index;
+}
+
+int32 FGOAPFactRegistry::FindFact(FName Fact) const
+{
+    FReadScopeLock ReadLock(Lock);
+    const int32* Found = FactToIndex.Find(Fact);
+    return Found ? *Found : INDEX_NONE;
+}
+
+FName FGOAPFactRegistry::GetFactName(int32 Index) const
+{
+    FReadScopeLock ReadLock(Lock);
+    return IndexToFact.IsValidIndex(Index) ? IndexToFact[Index] : NAME_None;
+}
+
+int32 FGOAPFactRegistry::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return IndexToFact.Num();
+}
+
+void FGOAPFactRegistry::RegisterFactsFromLoadedClasses()
+{
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        UClass* Class = *It;
+        if (Class->HasAnyClassFlags(CLASS_Abstract))
+        {
+            continue;
+        }
+
+        if (Class->IsChildOf(UGOAPAction::StaticClass()))
+        {
+            const UGOAPAction* Action = GetDefault<UGOAPAction>(Class);
+            for (const auto& Pair : Action->Preconditions)
+            {
+                FindOrAddFact(Pair.Key);
+            }
+            for (const auto& Pair : Action->Effects)
+            {
+                FindOrAddFact(Pair.Key);
+            }
+        }
+        else if (Class->IsChildOf(UGOAPGoal::StaticClass()))
+        {
+            const UGOAPGoal* Goal = GetDefault<UGOAPGoal>(Class);
+            for (const auto& Pair : Goal->DesiredState.Bools)
+            {
+                FindOrAddFact(Pair.Key);
+            }
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[GOAP] Fact registry initialized with %d facts."), Num());
+}
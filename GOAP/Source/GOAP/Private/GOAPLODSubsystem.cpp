@@ -0,0 +1,206 @@
+#include "GOAPLODSubsystem.h"
+#include "GOAPAgent.h"
+#include "GOAPStats.h"
+#include "GameFramework/PlayerController.h"
+
+UGOAPLODSubsystem::UGOAPLODSubsystem()
+{
+    HighLOD.MaxDistance = 2000.f;
+
+    MediumLOD.MaxDistance = 5000.f;
+    MediumLOD.TickInterval = 0.1f;
+    MediumLOD.ReactionTimeScale = 2.f;
+    MediumLOD.PlanBudgetScale = 0.5f;
+    MediumLOD.HeuristicWeight = 1.5f;
+    MediumLOD.PatrolRetargetInterval = 2.f;
+
+    LowLOD.MaxDistance = 15000.f;
+    LowLOD.TickInterval = 0.5f;
+    LowLOD.ReactionTimeScale = 4.f;
+    LowLOD.PlanBudgetScale = 0.25f;
+    LowLOD.HeuristicWeight = 3.f;
+    LowLOD.PatrolRetargetInterval = 8.f;
+
+    DormantLOD.TickInterval = 2.f;
+    DormantLOD.ReactionTimeScale = 4.f;
+    DormantLOD.PlanBudgetScale = 0.25f;
+    DormantLOD.HeuristicWeight = 3.f;
+    DormantLOD.PatrolRetargetInterval = 30.f;
+}
+
+void UGOAPLODSubsystem::RegisterAgent(AGOAPAgent* Agent)
+{
+    if (Agent)
+    {
+        Agents.AddUnique(Agent);
+    }
+}
+
+void UGOAPLODSubsystem::UnregisterAgent(AGOAPAgent* Agent)
+{
+    Agents.RemoveSingleSwap(Agent);
+}
+
+void UGOAPLODSubsystem::UpdateAgent(AGOAPAgent* Agent)
+{
+    if (!Agent || Agent->IsInPool())
+    {
+        return;
+    }
+
+    GatherViewLocations();
+    const EGOAPLOD LOD = SelectLOD(*Agent);
+    if (LOD != Agent->GetLOD())
+    {
+        Agent->SetLOD(LOD, GetLODSettings(LOD));
+    }
+}
+
+const FGOAPLODSettings& UGOAPLODSubsystem::GetLODSettings(EGOAPLOD LOD) const
+{
+    switch (LOD)
+    {
+    case EGOAPLOD::Medium:  return MediumLOD;
+    case EGOAPLOD::Low:     return LowLOD;
+    case EGOAPLOD::Dormant: return DormantLOD;
+    default:                return HighLOD;
+    }
+}
+
+int32 UGOAPLODSubsystem::GetNumAgentsAtLOD(EGOAPLOD LOD) const
+{
+    return LOD < EGOAPLOD::Num ? NumAgentsAtLOD[(int32)LOD] : 0;
+}
+
+void UGOAPLODSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    TimeUntilUpdate -= DeltaTime;
+    if (TimeUntilUpdate > 0.f || Agents.Num() == 0)
+    {
+        return;
+    }
+    TimeUntilUpdate = UpdateInterval;
+
+    GatherViewLocations();
+
+    FMemory::Memzero(NumAgentsAtLOD);
+    for (int32 Index = Agents.Num() - 1; Index >= 0; --Index)
+    {
+        AGOAPAgent* Agent = Agents[Index].Get();
+        if (!Agent)
+        {
+            Agents.RemoveAtSwap(Index);
+            continue;
+        }
+        if (Agent->IsInPool())
+        {
+            continue;
+        }
+
+        // Only agents whose level changed are touched, most of them stay where they are
+        const EGOAPLOD LOD = SelectLOD(*Agent);
+        if (LOD != Agent->GetLOD())
+        {
+            Agent->SetLOD(LOD, GetLODSettings(LOD));
+        }
+        ++NumAgentsAtLOD[(int32)LOD];
+    }
+
+    SET_DWORD_STAT(STAT_GOAPAgentsLODHigh, NumAgentsAtLOD[(int32)EGOAPLOD::High]);
+    SET_DWORD_STAT(STAT_GOAPAgentsLODMedium, NumAgentsAtLOD[(int32)EGOAPLOD::Medium]);
+    SET_DWORD_STAT(STAT_GOAPAgentsLODLow, NumAgentsAtLOD[(int32)EGOAPLOD::Low]);
+    SET_DWORD_STAT(STAT_GOAPAgentsLODDormant, NumAgentsAtLOD[(int32)EGOAPLOD::Dormant]);
+}
+
+void UGOAPLODSubsystem::GatherViewLocations()
+{
+    ViewLocations.Reset();
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (PlayerController && PlayerController->IsLocalController())
+        {
+            FVector Location;
+            FRotator Rotation;
+            PlayerController->GetPlayerViewPoint(Location, Rotation);
+            ViewLocations.Add(Location);
+        }
+    }
+}
+
+EGOAPLOD UGOAPLODSubsystem::SelectLOD(const AGOAPAgent& Agent) const
+{
+    if (Selector.IsBound())
+    {
+        return Selector.Execute(&Agent);
+    }
+
+    if (ViewLocations.Num() == 0)
+    {
+        return EGOAPLOD::High;
+    }
+
+    const FVector AgentLocation = Agent.GetActorLocation();
+    float MinDistSquared = MAX_flt;
+    for (const FVector& ViewLocation : ViewLocations)
+    {
+        MinDistSquared = FMath::Min(MinDistSquared, FVector::DistSquared(AgentLocation, ViewLocation));
+    }
+    const float Distance = FMath::Sqrt(MinDistSquared);
+
+    // Dropping to a lower level needs the extra hysteresis distance, rising does not
+    const EGOAPLOD LOD = GetLODForDistance(Distance);
+    if (LOD > Agent.GetLOD())
+    {
+        return FMath::Max(Agent.GetLOD(), GetLODForDistance(Distance - Hysteresis));
+    }
+    return LOD;
+}
+
+EGOAPLOD UGOAPLODSubsystem::GetLODForDistance(float Distance) const
+{
+    if (Distance < HighLOD.MaxDistance)
+    {
+        return EGOAPLOD::High;
+    }
+    if (Distance < MediumLOD.MaxDistance)
+    {
+        return EGOAPLOD::Medium;
+    }
+    if (Distance < LowLOD.MaxDistance)
+    {
+        return EGOAPLOD::Low;
+    }
+    return EGOAPLOD::Dormant;
+}
+
+TStatId UGOAPLODSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGOAPLODSubsystem, STATGROUP_Tickables);
+}
+
+void UGOAPLODSubsystem::Deinitialize()
+{
+    UE_LOG(LogTemp, Log, TEXT("[GOAP] LOD: %d agents registered, %d dormant at the last update."),
+        Agents.Num(), NumAgentsAtLOD[(int32)EGOAPLOD::Dormant]);
+
+    Agents.Reset();
+    ViewLocations.Reset();
+    Selector.Unbind();
+
+    Super::Deinitialize();
+}
+
+bool UGOAPLODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,141 @@
+#include "GOAPPlanCacheSubsystem.h"
+#include "GOAPStats.h"
+
+UGOAPPlanCacheSubsystem::UGOAPPlanCacheSubsystem()
+{
+}
+
+void UGOAPPlanCacheSubsystem::Deinitialize()
+{
+    UE_LOG(LogTemp, Log, TEXT("[GOAP] Plan cache: %lld hits, %lld misses, %d entries."), Hits, Misses, Lookup.Num());
+    Clear();
+    Super::Deinitialize();
+}
+
+bool UGOAPPlanCacheSubsystem::Find(const FGOAPPlanCacheKey& Key, TArray<int32>& OutActionIndices, bool& bOutReachable)
+{
+    const int32* EntryIndex = Lookup.Find(Key.GetHash());
+    if (!EntryIndex || !(Entries[*EntryIndex].Key == Key))
+    {
+        ++Misses;
+        INC_DWORD_STAT(STAT_GOAPPlanCacheMisses);
+        CSV_CUSTOM_STAT(GOAP, PlanCacheMisses, 1, ECsvCustomStatOp::Accumulate);
+        SET_FLOAT_STAT(STAT_GOAPPlanCacheHitRate, (float)Hits / (float)(Hits + Misses));
+        return false;
+    }
+
+    ++Hits;
+    INC_DWORD_STAT(STAT_GOAPPlanCacheHits);
+    CSV_CUSTOM_STAT(GOAP, PlanCacheHits, 1, ECsvCustomStatOp::Accumulate);
+    SET_FLOAT_STAT(STAT_GOAPPlanCacheHitRate, (float)Hits / (float)(Hits + Misses));
+
+    // Move to the front of the LRU list
+    Unlink(*EntryIndex);
+    LinkAtHead(*EntryIndex);
+
+    const FEntry& Entry = Entries[*EntryIndex];
+    OutActionIndices = Entry.ActionIndices;
+    bOutReachable = Entry.bReachable;
+    return true;
+}
+
+bool UGOAPPlanCacheSubsystem::AddSearchResult(const FGOAPPlanCacheKey& Key, const TArray<int32>& ActionIndices, bool bFoundPlan, EGOAPSearchFailure Failure)
+{
+    if (!bFoundPlan && Failure != EGOAPSearchFailure::Unreachable && Failure != EGOAPSearchFailure::Exhausted)
+    {
+        return false;
+    }
+
+    Add(Key, ActionIndices, bFoundPlan);
+    return MaxEntries > 0;
+}
+
+void UGOAPPlanCacheSubsystem::Add(const FGOAPPlanCacheKey& Key, const TArray<int32>& ActionIndices, bool bReachable)
+{
+    if (MaxEntries <= 0)
+    {
+        return;
+    }
+
+    const uint64 Hash = Key.GetHash();
+
+    int32 EntryIndex = INDEX_NONE;
+    if (const int32* Existing = Lookup.Find(Hash))
+    {
+        // Same key refreshes the entry, a colliding key simply replaces it
+        EntryIndex = *Existing;
+        Unlink(EntryIndex);
+    }
+    else if (Lookup.Num() >= MaxEntries && Tail != INDEX_NONE)
+    {
+        // Evict the least recently used plan and reuse its slot
+        EntryIndex = Tail;
+        Unlink(EntryIndex);
+        Lookup.Remove(Entries[EntryIndex].Hash);
+        Lookup.Add(Hash, EntryIndex);
+    }
+    else
+    {
+        EntryIndex = Entries.AddDefaulted();
+        Lookup.Add(Hash, EntryIndex);
+    }
+
+    FEntry& Entry = Entries[EntryIndex];
+    Entry.Key = Key;
+    Entry.Hash = Hash;
+    Entry.ActionIndices = bReachable ? ActionIndices : TArray<int32>();
+    Entry.bReachable = bReachable;
+    LinkAtHead(EntryIndex);
+}
+
+void UGOAPPlanCacheSubsystem::Clear()
+{
+    Entries.Reset();
+    Lookup.Reset();
+    Head = INDEX_NONE;
+    Tail = INDEX_NONE;
+}
+
+void UGOAPPlanCacheSubsystem::Unlink(int32 EntryIndex)
+{
+    FEntry& Entry = Entries[EntryIndex];
+
+    if (Entry.Prev != INDEX_NONE)
+    {
+        Entries[Entry.Prev].Next = Entry.Next;
+    }
+    else if (Head == EntryIndex)
+    {
+        Head = Entry.Next;
+    }
+
+    if (Entry.Next != INDEX_NONE)
+    {
+        Entries[Entry.Next].Prev = Entry.Prev;
+    }
+    else if (Tail == EntryIndex)
+    {
+        Tail = Entry.Prev;
+    }
+
+    Entry.Prev = INDEX_NONE;
+    Entry.Next = INDEX_NONE;
+}
+
+void UGOAPPlanCacheSubsystem::LinkAtHead(int32 EntryIndex)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    Entry.Prev = INDEX_NONE;
+    Entry.Next = Head;
+
+    if (Head != INDEX_NONE)
+    {
+        Entries[Head].Prev = EntryIndex;
+    }
+    Head = EntryIndex;
+
+    if (Tail == INDEX_NONE)
+    {
+        Tail = EntryIndex;
+    }
+}
@@ -1,185 +1,444 @@
 #include "GOAPPlanner.h"
 #include "Actions/GOAPAction.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
 
-// Set up for categorizing debug information
-#define GOAP_LOG_PLANNER(Level, RequiredLevel, Format, ...) \
-    if (Level >= RequiredLevel) \
-    { \
-        UE_LOG(LogTemp, Warning, TEXT(Format), ##__VA_ARGS__); \
-    }
+// The core mirrors the engine enums, Default search mode aside
+static_assert((uint8)EGOAPHeuristic::GoalCount == (uint8)GOAPCore::EHeuristic::GoalCount
+    && (uint8)EGOAPHeuristic::Max == (uint8)GOAPCore::EHeuristic::Max
+    && (uint8)EGOAPHeuristic::Add == (uint8)GOAPCore::EHeuristic::Add
+    && (uint8)EGOAPHeuristic::FF == (uint8)GOAPCore::EHeuristic::FF, "EGOAPHeuristic must match GOAPCore::EHeuristic");
+static_assert((uint8)EGOAPDebugLevel::None == (uint8)GOAPCore::EDebugLevel::None
+    && (uint8)EGOAPDebugLevel::Minimal == (uint8)GOAPCore::EDebugLevel::Minimal
+    && (uint8)EGOAPDebugLevel::Detailed == (uint8)GOAPCore::EDebugLevel::Detailed, "EGOAPDebugLevel must match GOAPCore::EDebugLevel");
 
-// Internal planner node struct
-struct FPlanNode
+static GOAPCore::EHeuristic ToCore(EGOAPHeuristic Heuristic)
 {
-    FGOAPWorldState State;
-    TArray<UGOAPAction*> Path;
-    float G = 0.f;
-    float H = 0.f;
-    float F() const { return G + H; }
-};
+    return (GOAPCore::EHeuristic)Heuristic;
+}
 
-// Helper functions
-static FString SerializeWorldState(const FGOAPWorldState& S)
+static GOAPCore::EDebugLevel ToCore(EGOAPDebugLevel DebugLevel)
 {
-    TArray<FName> Keys;
-    S.Bools.GenerateKeyArray(Keys);
-    Keys.Sort([](const FName& A, const FName& B) { return A.ToString() < B.ToString(); });
+    return (GOAPCore::EDebugLevel)DebugLevel;
+}
 
-    FString Out;
-    for (const FName& K : Keys)
+static GOAPCore::ESearchMode ToCore(EGOAPSearchMode SearchMode)
+{
+    switch (SearchMode)
     {
-        const bool* V = S.Bools.Find(K);
-        Out += FString::Printf(TEXT("%s=%d;"), *K.ToString(), V && *V ? 1 : 0);
+    case EGOAPSearchMode::Regressive: return GOAPCore::ESearchMode::Regressive;
+    case EGOAPSearchMode::Incremental: return GOAPCore::ESearchMode::Incremental;
+    default: return GOAPCore::ESearchMode::Forward;
     }
-    return Out;
 }
 
-static int32 UnsatisfiedGoalCount(const FGOAPWorldState& State, const FGOAPWorldState& Goal)
+// Log lines of every search end up where the planner always logged
+static void LogPlannerMessage(const char* Message)
 {
-    int32 Count = 0;
-    for (const auto& Kv : Goal.Bools)
-    {
-        const bool* Found = State.Bools.Find(Kv.Key);
-        if (!Found || *Found != Kv.Value)
-        {
-            ++Count;
-        }
-    }
-    return Count;
+    UE_LOG(LogTemp, Warning, TEXT("%s"), UTF8_TO_TCHAR(Message));
 }
 
-static bool SatisfiesPreconditions(const FGOAPWorldState& State, const TMap<FName, bool>& Preconditions)
+FString UGOAPPlanner::DumpPlannerTrace(const FString& FilePath)
 {
-    for (const auto& Kv : Preconditions)
+    const FString Path = FilePath.IsEmpty()
+        ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GOAP"), FString::Printf(TEXT("PlannerTrace_%s.goaptrace"), *FDateTime::Now().ToString()))
+        : FilePath;
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), /*Tree*/ true);
+
+    GOAPCore::FTraceData Data;
+    GOAPCore::FTraceRegistry::Get().Capture(Data);
+    if (!GOAPCore::WriteTraceFile(TCHAR_TO_UTF8(*FPaths::ConvertRelativePathToFull(Path)), Data))
     {
-        const bool* Found = State.Bools.Find(Kv.Key);
-        if (!Found || *Found != Kv.Value)
-        {
-            return false;
-        }
+        UE_LOG(LogTemp, Warning, TEXT("[GOAP] Could not write planner trace to %s"), *Path);
+        return FString();
     }
-    return true;
+
+    UE_LOG(LogTemp, Log, TEXT("[GOAP] Wrote %d planner trace events to %s"), (int32)Data.Events.size(), *Path);
+    return Path;
 }
 
-// Main planning function
+static FAutoConsoleCommand GOAPDumpPlannerTraceCommand(
+    TEXT("GOAP.DumpPlannerTrace"),
+    TEXT("Writes the planner trace of searches run at the Detailed debug level to a file. Optional argument: file path."),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            UGOAPPlanner::DumpPlannerTrace(Args.Num() > 0 ? Args[0] : FString());
+        }));
+
+// Blueprint entry point, converts the TMap states once and plans on packed states
 bool UGOAPPlanner::Plan(const FGOAPWorldState& Current,
     const FGOAPWorldState& Goal,
     const TArray<UGOAPAction*>& Actions,
     TArray<UGOAPAction*>& OutPlan,
-    EGOAPDebugLevel DebugLevel)
+    EGOAPDebugLevel DebugLevel,
+    EGOAPSearchMode SearchMode,
+    EGOAPHeuristic Heuristic)
+{
+    return PlanPacked(Current.ToPacked(), Goal.ToPacked(), Actions, OutPlan, DebugLevel, SearchMode, Heuristic);
+}
+
+bool UGOAPPlanner::PlanPacked(const FGOAPPackedState& Current,
+    const FGOAPPackedState& Goal,
+    const TArray<UGOAPAction*>& Actions,
+    TArray<UGOAPAction*>& OutPlan,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPSearchMode SearchMode,
+    EGOAPHeuristic Heuristic)
 {
     OutPlan.Reset();
 
-    if (Current.Satisfies(Goal))
+    TArray<int32> ActionIndices;
+    if (!PlanIndices(Current, Goal, Actions, ActionIndices, DebugLevel, SearchMode, Heuristic))
     {
-        GOAP_LOG_PLANNER(DebugLevel, EGOAPDebugLevel::Minimal,
-            "[Planner] Current state already satisfies goal.");
-        return true;
+        return false;
     }
 
-    TArray<FPlanNode> Open;
-    TSet<FString> Closed;
+    for (int32 ActionIndex : ActionIndices)
+    {
+        OutPlan.Add(Actions[ActionIndex]);
+    }
+    return true;
+}
 
-    FPlanNode Start;
-    Start.State = Current;
-    Start.G = 0.f;
-    Start.H = (float)UnsatisfiedGoalCount(Current, Goal);
-    Open.Add(MoveTemp(Start));
+const FGOAPActionSet& UGOAPPlanner::GetActionSet(const TArray<UGOAPAction*>& Actions)
+{
+    return *GetSharedActionSet(Actions);
+}
 
-    const int32 MaxIterations = 5000;
-    int32 Iter = 0;
+TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe> UGOAPPlanner::GetSharedActionSet(const TArray<UGOAPAction*>& Actions)
+{
+    // Compile the actions into flat arrays and inverted indices, reused while the actions stay the same.
+    // A changed list gets a new set, async searches still running keep the one they started with.
+    if (!ActionSet.IsValid() || !ActionSet->IsUpToDate(Actions))
+    {
+        TSharedRef<FGOAPActionSet, ESPMode::ThreadSafe> NewSet = MakeShared<FGOAPActionSet, ESPMode::ThreadSafe>();
+        NewSet->Build(Actions);
+        ActionSet = NewSet;
+    }
+    return ActionSet.ToSharedRef();
+}
 
-    while (Open.Num() > 0 && Iter++ < MaxIterations)
+bool UGOAPPlanner::PlanIndices(const FGOAPPackedState& Current,
+    const FGOAPPackedState& Goal,
+    const TArray<UGOAPAction*>& Actions,
+    TArray<int32>& OutActionIndices,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPSearchMode SearchMode,
+    EGOAPHeuristic Heuristic,
+    EGOAPSearchFailure* OutFailure)
+{
+    BeginPlan(Current, Goal, Actions, DebugLevel, SearchMode, Heuristic);
+    const EGOAPSearchStatus Status = Search.Step(MAX_int32);
+
+    OutActionIndices = Search.GetPlan();
+    if (OutFailure)
     {
-        int32 BestIndex = 0;
-        float BestF = Open[0].F();
-        for (int32 i = 1; i < Open.Num(); ++i)
-        {
-            if (Open[i].F() < BestF)
-            {
-                BestF = Open[i].F();
-                BestIndex = i;
-            }
-        }
+        *OutFailure = Search.GetStats().Failure;
+    }
+    return Status == EGOAPSearchStatus::Succeeded;
+}
 
-        FPlanNode Node = Open[BestIndex];
-        Open.RemoveAtSwap(BestIndex);
+bool UGOAPPlanner::PlanMultiGoal(const FGOAPPackedState& Current,
+    TConstArrayView<FGOAPGoalCandidate> Goals,
+    const TArray<UGOAPAction*>& Actions,
+    TArray<int32>& OutActionIndices,
+    int32& OutGoalIndex,
+    float CostWeight,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPHeuristic Heuristic)
+{
+    BeginPlanMultiGoal(Current, Goals, Actions, CostWeight, DebugLevel, Heuristic);
+    const EGOAPSearchStatus Status = Search.Step(MAX_int32);
 
-        GOAP_LOG_PLANNER(DebugLevel, EGOAPDebugLevel::Detailed,
-            "[Planner] Expanding node (G=%.2f, H=%.2f, F=%.2f) | OpenList=%d | Closed=%d",
-            Node.G, Node.H, Node.F(), Open.Num(), Closed.Num());
+    OutActionIndices = Search.GetPlan();
+    OutGoalIndex = Search.GetGoalIndex();
+    return Status == EGOAPSearchStatus::Succeeded;
+}
 
-        // Goal test
-        if (Node.State.Satisfies(Goal))
-        {
-            OutPlan = Node.Path;
-            GOAP_LOG_PLANNER(DebugLevel, EGOAPDebugLevel::Minimal,
-                "[Planner] Plan found with %d steps (G=%.2f, H=%.2f, Iter=%d)",
-                OutPlan.Num(), Node.G, Node.H, Iter);
+void UGOAPPlanner::BeginPlanMultiGoal(const FGOAPPackedState& Current,
+    TConstArrayView<FGOAPGoalCandidate> Goals,
+    const TArray<UGOAPAction*>& Actions,
+    float CostWeight,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPHeuristic Heuristic)
+{
+    Search.StartMultiGoal(GetSharedActionSet(Actions), Current, Goals, CostWeight, DebugLevel, MaxIterations, Heuristic);
+}
 
-            FString Seq;
-            for (UGOAPAction* A : OutPlan)
-            {
-                Seq += FString::Printf(TEXT("%s -> "), A ? *A->GetName() : TEXT("null"));
-            }
-            GOAP_LOG_PLANNER(DebugLevel, EGOAPDebugLevel::Minimal, "[GOAPPlanner] Plan sequence: %s", *Seq);
-            return true;
-        }
+bool UGOAPPlanner::PlanAnytime(const FGOAPPackedState& Current,
+    const FGOAPPackedState& Goal,
+    const TArray<UGOAPAction*>& Actions,
+    TArray<int32>& OutActionIndices,
+    double MaxMicroseconds,
+    float InitialWeight,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPSearchMode SearchMode,
+    EGOAPHeuristic Heuristic)
+{
+    BeginPlanAnytime(Current, Goal, Actions, InitialWeight, DebugLevel, SearchMode, Heuristic);
 
-        FString NodeKey = SerializeWorldState(Node.State);
-        if (Closed.Contains(NodeKey))
+    // Step returns after every published plan, keep refining until the budget is spent
+    const double EndTime = FPlatformTime::Seconds() + MaxMicroseconds * 1e-6;
+    EGOAPSearchStatus Status = Search.GetStatus();
+    while (Search.IsInProgress())
+    {
+        const double Remaining = (EndTime - FPlatformTime::Seconds()) * 1e6;
+        if (Remaining <= 0.0)
         {
-            continue;
+            break;
         }
-        Closed.Add(NodeKey);
+        Status = Search.Step(MAX_int32, Remaining);
+    }
 
-        // Expand by actions
-        for (UGOAPAction* Action : Actions)
-        {
-            if (!Action) continue;
+    OutActionIndices = Search.GetPlan();
+    return Search.GetNumSolutions() > 0 && Status != EGOAPSearchStatus::Failed;
+}
 
-            // Action preconditions must be satisfied in this node state
-            if (!SatisfiesPreconditions(Node.State, Action->Preconditions))
-            {
-                GOAP_LOG_PLANNER(DebugLevel, EGOAPDebugLevel::Detailed,
-                    "[Planner] Skipping %s (preconditions not met)", *Action->GetName());
-                continue;
-            }
+void UGOAPPlanner::BeginPlanAnytime(const FGOAPPackedState& Current,
+    const FGOAPPackedState& Goal,
+    const TArray<UGOAPAction*>& Actions,
+    float InitialWeight,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPSearchMode SearchMode,
+    EGOAPHeuristic Heuristic)
+{
+    Search.StartAnytime(GetSharedActionSet(Actions), Current, Goal, InitialWeight, AnytimeWeightStep,
+        DebugLevel, SearchMode, MaxIterations, Heuristic);
+}
 
-            // Build child node: state after applying action effects
-            FPlanNode Child;
-            Child.State = Node.State;
-            // Apply action effects into child.State
-            for (const auto& EffectKv : Action->Effects)
-            {
-                Child.State.Bools.FindOrAdd(EffectKv.Key) = EffectKv.Value;
-            }
+void UGOAPPlanner::BeginPlan(const FGOAPPackedState& Current,
+    const FGOAPPackedState& Goal,
+    const TArray<UGOAPAction*>& Actions,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPSearchMode SearchMode,
+    EGOAPHeuristic Heuristic)
+{
+    if (SearchMode == EGOAPSearchMode::Incremental)
+    {
+        Search.StartIncremental(GetSharedActionSet(Actions), Current, Goal, DebugLevel, MaxIterations, Heuristic);
+        return;
+    }
+
+    // An anytime search that never lowers its weight is plain weighted A*, done at its first plan
+    if (HeuristicWeight > 1.f)
+    {
+        Search.StartAnytime(GetSharedActionSet(Actions), Current, Goal, HeuristicWeight, 0.f,
+            DebugLevel, SearchMode, MaxIterations, Heuristic);
+        return;
+    }
+
+    Search.Start(GetSharedActionSet(Actions), Current, Goal, DebugLevel, SearchMode, MaxIterations, Heuristic);
+}
+
+EGOAPSearchStatus UGOAPPlanner::StepPlan(int32 MaxExpansions, double MaxMicroseconds)
+{
+    return Search.Step(MaxExpansions, MaxMicroseconds);
+}
+
+FGOAPAsyncPlanRequestRef UGOAPPlanner::PlanAsync(const FGOAPPackedState& Current,
+    const FGOAPPackedState& Goal,
+    const TArray<UGOAPAction*>& Actions,
+    FGOAPOnAsyncPlanComplete OnComplete,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPSearchMode SearchMode,
+    EGOAPHeuristic Heuristic)
+{
+    check(IsInGameThread());
 
-            // If already visited this resulting state, skip
-            FString ChildKey = SerializeWorldState(Child.State);
-            if (Closed.Contains(ChildKey))
+    // Everything the worker reads is copied or immutable, it never touches a UObject
+    FGOAPAsyncPlanRequestRef Request = MakeShared<FGOAPAsyncPlanRequest, ESPMode::ThreadSafe>();
+    Request->Current = Current;
+    Request->Goal = Goal;
+    Request->ActionSet = GetSharedActionSet(Actions);
+    Request->DebugLevel = DebugLevel;
+    Request->SearchMode = SearchMode;
+    Request->Heuristic = Heuristic;
+    Request->HeuristicWeight = HeuristicWeight;
+
+    return LaunchAsync(Request, MoveTemp(OnComplete));
+}
+
+FGOAPAsyncPlanRequestRef UGOAPPlanner::PlanMultiGoalAsync(const FGOAPPackedState& Current,
+    TConstArrayView<FGOAPGoalCandidate> Goals,
+    const TArray<UGOAPAction*>& Actions,
+    FGOAPOnAsyncPlanComplete OnComplete,
+    float CostWeight,
+    EGOAPDebugLevel DebugLevel,
+    EGOAPHeuristic Heuristic)
+{
+    check(IsInGameThread());
+
+    FGOAPAsyncPlanRequestRef Request = MakeShared<FGOAPAsyncPlanRequest, ESPMode::ThreadSafe>();
+    Request->Current = Current;
+    Request->Goals.Append(Goals.GetData(), Goals.Num());
+    Request->CostWeight = CostWeight;
+    Request->ActionSet = GetSharedActionSet(Actions);
+    Request->DebugLevel = DebugLevel;
+    Request->SearchMode = EGOAPSearchMode::Forward;
+    Request->Heuristic = Heuristic;
+
+    return LaunchAsync(Request, MoveTemp(OnComplete));
+}
+
+FGOAPAsyncPlanRequestRef UGOAPPlanner::LaunchAsync(const FGOAPAsyncPlanRequestRef& Request, FGOAPOnAsyncPlanComplete OnComplete)
+{
+    const int32 WorkerMaxIterations = MaxIterations;
+
+    Async(EAsyncExecution::ThreadPool, [Request, OnComplete = MoveTemp(OnComplete), WorkerMaxIterations]() mutable
+        {
+            if (!Request->IsCancelled())
             {
-                GOAP_LOG_PLANNER(DebugLevel, EGOAPDebugLevel::Detailed,
-                    "[Planner] Skipping %s (already visited state)", *Action->GetName());
-                continue;
+                // One search per worker thread, so its allocations stay warm between requests
+                static thread_local FGOAPPlanSearch WorkerSearch;
+                if (Request->Goals.Num() > 0)
+                {
+                    WorkerSearch.StartMultiGoal(Request->ActionSet.ToSharedRef(), Request->Current, Request->Goals,
+                        Request->CostWeight, Request->DebugLevel, WorkerMaxIterations, Request->Heuristic);
+                }
+                else if (Request->HeuristicWeight > 1.f)
+                {
+                    WorkerSearch.StartAnytime(Request->ActionSet.ToSharedRef(), Request->Current, Request->Goal,
+                        Request->HeuristicWeight, 0.f, Request->DebugLevel, Request->SearchMode, WorkerMaxIterations, Request->Heuristic);
+                }
+                else
+                {
+                    WorkerSearch.Start(Request->ActionSet.ToSharedRef(), Request->Current, Request->Goal,
+                        Request->DebugLevel, Request->SearchMode, WorkerMaxIterations, Request->Heuristic);
+                }
+
+                Request->bFoundPlan = WorkerSearch.Step(MAX_int32, 0.0, &Request->bCancelled) == EGOAPSearchStatus::Succeeded;
+                Request->ActionIndices = WorkerSearch.GetPlan();
+                Request->Failure = WorkerSearch.GetStats().Failure;
+                if (WorkerSearch.IsMultiGoal())
+                {
+                    Request->GoalIndex = WorkerSearch.GetGoalIndex();
+                    Request->Goal = WorkerSearch.GetGoal();
+                }
+                WorkerSearch.Reset();
             }
 
-            // Update path and costs
-            Child.Path = Node.Path;
-            Child.Path.Add(Action);
-            Child.G = Node.G + Action->Cost;
-            Child.H = (float)UnsatisfiedGoalCount(Child.State, Goal);
+            AsyncTask(ENamedThreads::GameThread, [Request, OnComplete = MoveTemp(OnComplete)]()
+                {
+                    if (!Request->IsCancelled())
+                    {
+                        OnComplete.ExecuteIfBound(Request);
+                    }
+                });
+        });
 
-            GOAP_LOG_PLANNER(DebugLevel, EGOAPDebugLevel::Detailed,
-                "[Planner] Added child via %s (G=%.2f, H=%.2f, F=%.2f)",
-                *Action->GetName(), Child.G, Child.H, Child.F());
+    return Request;
+}
 
-            // Add to open list
-            Open.Add(MoveTemp(Child));
-        }
+FGOAPPlanSearch::FGOAPPlanSearch()
+{
+    Core.SetLogSink(&LogPlannerMessage);
+}
+
+void FGOAPPlanSearch::Start(const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet,
+    const FGOAPPackedState& InCurrent,
+    const FGOAPPackedState& InGoal,
+    EGOAPDebugLevel InDebugLevel,
+    EGOAPSearchMode InSearchMode,
+    int32 InMaxIterations,
+    EGOAPHeuristic InHeuristic)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(GOAPSearchStart);
+    bStatsRecorded = false;
+    ActionSet = InActionSet;
+    Core.Start(*InActionSet, InCurrent, InGoal, ToCore(InDebugLevel), ToCore(InSearchMode), InMaxIterations, ToCore(InHeuristic));
+    SyncPlan();
+}
+
+bool FGOAPPlanSearch::StartIncremental(const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet,
+    const FGOAPPackedState& InCurrent,
+    const FGOAPPackedState& InGoal,
+    EGOAPDebugLevel InDebugLevel,
+    int32 InMaxIterations,
+    EGOAPHeuristic InHeuristic)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(GOAPSearchStart);
+    bStatsRecorded = false;
+
+    // The core compares action set signatures, the previous set only has to live through the call
+    const TSharedPtr<const FGOAPActionSet, ESPMode::ThreadSafe> PreviousActionSet = ActionSet;
+    ActionSet = InActionSet;
+
+    const bool bReused = Core.StartIncremental(*InActionSet, InCurrent, InGoal, ToCore(InDebugLevel), InMaxIterations, ToCore(InHeuristic));
+    SyncPlan();
+    return bReused;
+}
+
+void FGOAPPlanSearch::StartMultiGoal(const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet,
+    const FGOAPPackedState& InCurrent,
+    TConstArrayView<FGOAPGoalCandidate> InGoals,
+    float InCostWeight,
+    EGOAPDebugLevel InDebugLevel,
+    int32 InMaxIterations,
+    EGOAPHeuristic InHeuristic)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(GOAPSearchStart);
+    bStatsRecorded = false;
+    ActionSet = InActionSet;
+    Core.StartMultiGoal(*InActionSet, InCurrent, InGoals.GetData(), InGoals.Num(), InCostWeight,
+        ToCore(InDebugLevel), InMaxIterations, ToCore(InHeuristic));
+    SyncPlan();
+}
+
+void FGOAPPlanSearch::StartAnytime(const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet,
+    const FGOAPPackedState& InCurrent,
+    const FGOAPPackedState& InGoal,
+    float InInitialWeight,
+    float InWeightStep,
+    EGOAPDebugLevel InDebugLevel,
+    EGOAPSearchMode InSearchMode,
+    int32 InMaxIterations,
+    EGOAPHeuristic InHeuristic)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(GOAPSearchStart);
+    bStatsRecorded = false;
+    ActionSet = InActionSet;
+    Core.StartAnytime(*InActionSet, InCurrent, InGoal, InInitialWeight, InWeightStep,
+        ToCore(InDebugLevel), ToCore(InSearchMode), InMaxIterations, ToCore(InHeuristic));
+    SyncPlan();
+}
+
+EGOAPSearchStatus FGOAPPlanSearch::Step(int32 MaxExpansions, double MaxMicroseconds, const std::atomic<bool>* bCancelled)
+{
+    const EGOAPSearchStatus Result = Core.Step(MaxExpansions, MaxMicroseconds, bCancelled);
+    SyncPlan();
+    return Result;
+}
+
+void FGOAPPlanSearch::Reset()
+{
+    Core.Reset();
+    ActionSet.Reset();
+    Plan.Reset();
+    bStatsRecorded = false;
+}
+
+EGOAPSearchMode FGOAPPlanSearch::GetSearchMode() const
+{
+    switch (Core.GetSearchMode())
+    {
+    case GOAPCore::ESearchMode::Regressive: return EGOAPSearchMode::Regressive;
+    case GOAPCore::ESearchMode::Incremental: return EGOAPSearchMode::Incremental;
+    default: return EGOAPSearchMode::Forward;
     }
+}
 
-    GOAP_LOG_PLANNER(DebugLevel, EGOAPDebugLevel::Minimal,
-        "[Planner] No plan found after %d iterations (Open=%d, Closed=%d)", Iter, Open.Num(), Closed.Num());
-    return false;
+void FGOAPPlanSearch::SyncPlan()
+{
+    const std::vector<int32_t>& CorePlan = Core.GetPlan();
+    Plan.Reset((int32)CorePlan.size());
+    Plan.Append(CorePlan.data(), (int32)CorePlan.size());
+
+    const EGOAPSearchStatus Status = Core.GetStatus();
+    if (!bStatsRecorded && (Status == EGOAPSearchStatus::Succeeded || Status == EGOAPSearchStatus::Failed))
+    {
+        bStatsRecorded = true;
+        GOAPRecordSearchStats(Core.GetStats(), Plan.Num());
+    }
 }
@@ -0,0 +1,181 @@
+#include "GOAPReplanSubsystem.h"
+#include "GOAPAgent.h"
+
+void UGOAPReplanSubsystem::RequestReplan(AGOAPAgent* Agent, EGOAPUrgency Urgency)
+{
+    if (!Agent)
+    {
+        return;
+    }
+
+    const TWeakObjectPtr<AGOAPAgent> Key(Agent);
+    FQueuedAgent* Existing = Queued.Find(Key);
+    if (Existing)
+    {
+        if (Existing->Urgency >= Urgency)
+        {
+            return; // already waiting in a class at least this urgent
+        }
+
+        // Move up, the entry left in the old queue is skipped when reached
+        --Queues[(int32)Existing->Urgency].NumQueued;
+    }
+    else
+    {
+        Existing = &Queued.Add(Key);
+    }
+    Existing->Urgency = Urgency;
+    Existing->Sequence = ++NextSequence;
+
+    FReplanQueue& Queue = Queues[(int32)Urgency];
+    Queue.Entries.Add(FQueuedReplan{ Key, GetNow(), Existing->Sequence });
+    ++Queue.NumQueued;
+
+    PeakQueueDepth = FMath::Max(PeakQueueDepth, Queued.Num());
+}
+
+void UGOAPReplanSubsystem::CancelReplan(AGOAPAgent* Agent)
+{
+    FQueuedAgent Removed;
+    if (Queued.RemoveAndCopyValue(TWeakObjectPtr<AGOAPAgent>(Agent), Removed))
+    {
+        --Queues[(int32)Removed.Urgency].NumQueued;
+    }
+}
+
+bool UGOAPReplanSubsystem::IsQueued(const AGOAPAgent* Agent) const
+{
+    return Queued.Contains(TWeakObjectPtr<AGOAPAgent>(const_cast<AGOAPAgent*>(Agent)));
+}
+
+int32 UGOAPReplanSubsystem::GetQueueDepth(EGOAPUrgency Urgency) const
+{
+    return Urgency < EGOAPUrgency::Num ? Queues[(int32)Urgency].NumQueued : 0;
+}
+
+void UGOAPReplanSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    ReplansLastFrame = 0;
+    if (Queued.Num() == 0)
+    {
+        return;
+    }
+
+    const double Now = GetNow();
+    const double StartTime = FPlatformTime::Seconds();
+    const double Budget = FrameBudgetMs * 0.001;
+
+    // Overdue requests first, whatever the budget says, so every class keeps its latency bound
+    for (int32 Class = (int32)EGOAPUrgency::Num - 1; Class >= 0; --Class)
+    {
+        while (ServeNext((EGOAPUrgency)Class, /*bOnlyOverdue*/ true, Now))
+        {
+            ++ReplansLastFrame;
+        }
+    }
+
+    // Then spend what is left of the budget, most urgent class first
+    for (int32 Class = (int32)EGOAPUrgency::Num - 1; Class >= 0; --Class)
+    {
+        while ((ReplansLastFrame == 0 || FPlatformTime::Seconds() - StartTime < Budget)
+            && ServeNext((EGOAPUrgency)Class, /*bOnlyOverdue*/ false, Now))
+        {
+            ++ReplansLastFrame;
+        }
+    }
+}
+
+bool UGOAPReplanSubsystem::ServeNext(EGOAPUrgency Urgency, bool bOnlyOverdue, double Now)
+{
+    FReplanQueue& Queue = Queues[(int32)Urgency];
+    const float MaxLatency = GetMaxLatency(Urgency);
+    bool bServed = false;
+
+    while (!Queue.IsEmpty())
+    {
+        const FQueuedReplan& Entry = Queue.Entries[Queue.Head];
+
+        // Skip entries whose agent is gone, was cancelled, moved to a more urgent class or
+        // served and queued again, which left this entry behind with an old request time
+        const FQueuedAgent* QueuedAgent = Queued.Find(Entry.Agent);
+        const bool bLive = QueuedAgent && QueuedAgent->Sequence == Entry.Sequence;
+        if (!Entry.Agent.IsValid() || !bLive)
+        {
+            if (bLive)
+            {
+                Queued.Remove(Entry.Agent);
+                --Queue.NumQueued;
+            }
+            ++Queue.Head;
+            continue;
+        }
+
+        if (bOnlyOverdue && Now - Entry.RequestTime < MaxLatency)
+        {
+            return false;
+        }
+
+        AGOAPAgent* Agent = Entry.Agent.Get();
+        Queued.Remove(Entry.Agent);
+        --Queue.NumQueued;
+        ++Queue.Head;
+
+        Agent->PlanActions();
+        bServed = true;
+        break;
+    }
+
+    // Drop consumed entries once the queue drains, or once they make up most of it
+    if (Queue.IsEmpty())
+    {
+        Queue.Entries.Reset();
+        Queue.Head = 0;
+    }
+    else if (Queue.Head > 64 && Queue.Head * 2 > Queue.Entries.Num())
+    {
+        Queue.Entries.RemoveAt(0, Queue.Head);
+        Queue.Head = 0;
+    }
+    return bServed;
+}
+
+float UGOAPReplanSubsystem::GetMaxLatency(EGOAPUrgency Urgency) const
+{
+    switch (Urgency)
+    {
+    case EGOAPUrgency::High:   return MaxLatencyHigh;
+    case EGOAPUrgency::Normal: return MaxLatencyNormal;
+    default:                   return MaxLatencyLow;
+    }
+}
+
+double UGOAPReplanSubsystem::GetNow() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetRealTimeSeconds() : FPlatformTime::Seconds();
+}
+
+TStatId UGOAPReplanSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGOAPReplanSubsystem, STATGROUP_Tickables);
+}
+
+void UGOAPReplanSubsystem::Deinitialize()
+{
+    UE_LOG(LogTemp, Log, TEXT("[GOAP] Replan scheduler: peak queue depth %d."), PeakQueueDepth);
+
+    for (FReplanQueue& Queue : Queues)
+    {
+        Queue = FReplanQueue();
+    }
+    Queued.Reset();
+
+    Super::Deinitialize();
+}
+
+bool UGOAPReplanSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
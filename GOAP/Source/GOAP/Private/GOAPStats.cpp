@@ -0,0 +1,63 @@
+#include "GOAPStats.h"
+#include "GOAPCore/PlanSearch.h"
+
+DEFINE_STAT(STAT_GOAPPlannerTick);
+DEFINE_STAT(STAT_GOAPExecureGoal);
+DEFINE_STAT(STAT_GOAPSearches);
+DEFINE_STAT(STAT_GOAPNodesExpanded);
+DEFINE_STAT(STAT_GOAPNodesGenerated);
+DEFINE_STAT(STAT_GOAPPlanSteps);
+DEFINE_STAT(STAT_GOAPFailedUnreachable);
+DEFINE_STAT(STAT_GOAPFailedExhausted);
+DEFINE_STAT(STAT_GOAPFailedIterationLimit);
+DEFINE_STAT(STAT_GOAPFailedCancelled);
+DEFINE_STAT(STAT_GOAPPlanCacheHits);
+DEFINE_STAT(STAT_GOAPPlanCacheMisses);
+DEFINE_STAT(STAT_GOAPPeakOpen);
+DEFINE_STAT(STAT_GOAPPeakClosed);
+DEFINE_STAT(STAT_GOAPPlanCacheHitRate);
+DEFINE_STAT(STAT_GOAPAgentsLODHigh);
+DEFINE_STAT(STAT_GOAPAgentsLODMedium);
+DEFINE_STAT(STAT_GOAPAgentsLODLow);
+DEFINE_STAT(STAT_GOAPAgentsLODDormant);
+
+CSV_DEFINE_CATEGORY_MODULE(GOAP_API, GOAP, true);
+
+void GOAPRecordSearchStats(const GOAPCore::FSearchStats& Stats, int32 PlanLength)
+{
+    INC_DWORD_STAT(STAT_GOAPSearches);
+    INC_DWORD_STAT_BY(STAT_GOAPNodesExpanded, Stats.NodesExpanded);
+    INC_DWORD_STAT_BY(STAT_GOAPNodesGenerated, Stats.NodesGenerated);
+    INC_DWORD_STAT_BY(STAT_GOAPPlanSteps, PlanLength);
+    SET_DWORD_STAT(STAT_GOAPPeakOpen, Stats.PeakOpen);
+    SET_DWORD_STAT(STAT_GOAPPeakClosed, Stats.PeakClosed);
+
+    CSV_CUSTOM_STAT(GOAP, Searches, 1, ECsvCustomStatOp::Accumulate);
+    CSV_CUSTOM_STAT(GOAP, NodesExpanded, Stats.NodesExpanded, ECsvCustomStatOp::Accumulate);
+    CSV_CUSTOM_STAT(GOAP, NodesGenerated, Stats.NodesGenerated, ECsvCustomStatOp::Accumulate);
+    CSV_CUSTOM_STAT(GOAP, PlanSteps, PlanLength, ECsvCustomStatOp::Accumulate);
+    CSV_CUSTOM_STAT(GOAP, PeakOpen, Stats.PeakOpen, ECsvCustomStatOp::Max);
+    CSV_CUSTOM_STAT(GOAP, PeakClosed, Stats.PeakClosed, ECsvCustomStatOp::Max);
+
+    switch (Stats.Failure)
+    {
+    case GOAPCore::ESearchFailure::Unreachable:
+        INC_DWORD_STAT(STAT_GOAPFailedUnreachable);
+        CSV_CUSTOM_STAT(GOAP, FailedUnreachable, 1, ECsvCustomStatOp::Accumulate);
+        break;
+    case GOAPCore::ESearchFailure::Exhausted:
+        INC_DWORD_STAT(STAT_GOAPFailedExhausted);
+        CSV_CUSTOM_STAT(GOAP, FailedExhausted, 1, ECsvCustomStatOp::Accumulate);
+        break;
+    case GOAPCore::ESearchFailure::IterationLimit:
+        INC_DWORD_STAT(STAT_GOAPFailedIterationLimit);
+        CSV_CUSTOM_STAT(GOAP, FailedIterationLimit, 1, ECsvCustomStatOp::Accumulate);
+        break;
+    case GOAPCore::ESearchFailure::Cancelled:
+        INC_DWORD_STAT(STAT_GOAPFailedCancelled);
+        CSV_CUSTOM_STAT(GOAP, FailedCancelled, 1, ECsvCustomStatOp::Accumulate);
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,40 @@
+#include "GOAPTypes.h"
+
+FGOAPPackedState GOAPPackFacts(const TMap<FName, bool>& Facts)
+{
+    FGOAPPackedState Out;
+    GOAPPackFacts(Facts, Out);
+    return Out;
+}
+
+bool GOAPPackFacts(const TMap<FName, bool>& Facts, FGOAPPackedState& OutState)
+{
+    FGOAPFactRegistry& Registry = FGOAPFactRegistry::Get();
+
+    bool bComplete = true;
+    OutState = FGOAPPackedState();
+    for (const auto& Pair : Facts)
+    {
+        const int32 Index = Registry.FindOrAddFact(Pair.Key);
+        if (Index != INDEX_NONE)
+        {
+            OutState.SetFact(Index, Pair.Value);
+        }
+        else
+        {
+            bComplete = false;
+        }
+    }
+    return bComplete;
+}
+
+void GOAPUnpackFacts(const FGOAPPackedState& State, TMap<FName, bool>& OutFacts)
+{
+    const FGOAPFactRegistry& Registry = FGOAPFactRegistry::Get();
+
+    OutFacts.Reset();
+    GOAPCore::ForEachFact(State.Mask, [&](int32 Index)
+        {
+            OutFacts.Add(Registry.GetFactName(Index), (State.Values[Index >> 6] & (1ull << (Index & 63))) != 0);
+        });
+}
@@ -12,6 +12,29 @@
 UGOAPWorldStateComponent::UGOAPWorldStateComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
+    bWantsInitializeComponent = true;
+}
+
+void UGOAPWorldStateComponent::InitializeComponent()
+{
+    Super::InitializeComponent();
+
+    // Pick up the facts assigned in the editor
+    InitialState = CurrentState;
+    RebuildPackedState();
+    RebuildChannels();
+}
+
+void UGOAPWorldStateComponent::ResetState()
+{
+    CurrentState = InitialState;
+    RebuildPackedState();
+    RebuildChannels();
+}
+
+void UGOAPWorldStateComponent::RebuildPackedState()
+{
+    PackedState = CurrentState.ToPacked();
 }
 
 FString UGOAPWorldStateComponent::GetStateAsString() const
@@ -23,39 +46,155 @@ FString UGOAPWorldStateComponent::GetStateAsString() const
             *Pair.Key.ToString(),
             Pair.Value ? TEXT("true") : TEXT("false"));
     }
+    for (int32 Channel = 0; Channel < ChannelStates.Num() && Channel < NumericChannels.Num(); ++Channel)
+    {
+        Out += FString::Printf(TEXT("%s=%.1f "), *NumericChannels[Channel].Name.ToString(), ChannelStates[Channel].Value);
+    }
     return Out;
 }
 
-void UGOAPWorldStateComponent::Apply(const TMap<FName, bool>& Effects)
+void UGOAPWorldStateComponent::RebuildChannels()
 {
-    bool bChanged = false; // track if anything actually changed
+    ChannelStates.Reset();
+    ThresholdStates.Reset();
 
-    for (const auto& E : Effects)
+    FGOAPFactRegistry& Registry = FGOAPFactRegistry::Get();
+    FGOAPPackedState ChangedFacts;
+
+    for (const FGOAPNumericChannel& Channel : NumericChannels)
     {
-        bool* ExistingValue = CurrentState.Bools.Find(E.Key);
+        FChannelState& State = ChannelStates.AddDefaulted_GetRef();
+        State.MinValue = FMath::Min(Channel.MinValue, Channel.MaxValue);
+        State.MaxValue = FMath::Max(Channel.MinValue, Channel.MaxValue);
+        State.Value = FMath::Clamp(Channel.InitialValue, State.MinValue, State.MaxValue);
+        State.FirstThreshold = ThresholdStates.Num();
 
-        if (ExistingValue)
+        for (const FGOAPChannelThreshold& Threshold : Channel.Thresholds)
         {
-            if (*ExistingValue != E.Value)
+            const int32 FactIndex = Registry.FindOrAddFact(Threshold.Fact);
+            if (FactIndex == INDEX_NONE)
             {
-                GOAP_WORLDSTATE_LOG(this, EGOAPDebugLevel::Minimal, "WorldState changed: %s = %s",
-                    *E.Key.ToString(), E.Value ? TEXT("true") : TEXT("false"));
-                *ExistingValue = E.Value;
-                bChanged = true;
+                continue;
             }
+
+            FThresholdState& Derived = ThresholdStates.AddDefaulted_GetRef();
+            Derived.Fact = Threshold.Fact;
+            Derived.FactIndex = FactIndex;
+            Derived.bTrueBelow = Threshold.bTrueBelow;
+            Derived.EnterValue = Threshold.Threshold;
+            Derived.ExitValue = Threshold.bTrueBelow
+                ? Threshold.Threshold + FMath::Max(0.f, Threshold.Hysteresis)
+                : Threshold.Threshold - FMath::Max(0.f, Threshold.Hysteresis);
+            Derived.bActive = Derived.bTrueBelow ? State.Value <= Derived.EnterValue : State.Value >= Derived.EnterValue;
+
+            // Derived facts are always known, so the planner can rely on them
+            SetFact(Derived.Fact, FactIndex, Derived.bActive, ChangedFacts);
+        }
+        State.NumThresholds = ThresholdStates.Num() - State.FirstThreshold;
+    }
+
+    BroadcastChanges(ChangedFacts);
+}
+
+int32 UGOAPWorldStateComponent::FindChannel(FName Name) const
+{
+    return NumericChannels.IndexOfByPredicate([Name](const FGOAPNumericChannel& Channel) { return Channel.Name == Name; });
+}
+
+float UGOAPWorldStateComponent::GetChannelValue(int32 Channel) const
+{
+    return ChannelStates.IsValidIndex(Channel) ? ChannelStates[Channel].Value : 0.f;
+}
+
+void UGOAPWorldStateComponent::AddChannelValue(int32 Channel, float Delta)
+{
+    if (ChannelStates.IsValidIndex(Channel))
+    {
+        SetChannelValue(Channel, ChannelStates[Channel].Value + Delta);
+    }
+}
+
+void UGOAPWorldStateComponent::SetChannelValue(int32 Channel, float Value)
+{
+    if (!ChannelStates.IsValidIndex(Channel))
+    {
+        return;
+    }
+
+    FChannelState& State = ChannelStates[Channel];
+    State.Value = FMath::Clamp(Value, State.MinValue, State.MaxValue);
+
+    // The common case: no threshold crossed, nothing but the value is written
+    FGOAPPackedState ChangedFacts;
+    for (int32 Index = State.FirstThreshold; Index < State.FirstThreshold + State.NumThresholds; ++Index)
+    {
+        FThresholdState& Derived = ThresholdStates[Index];
+        const bool bActive = Derived.bActive
+            ? (Derived.bTrueBelow ? !(State.Value > Derived.EnterValue && State.Value >= Derived.ExitValue)
+                                  : !(State.Value < Derived.EnterValue && State.Value <= Derived.ExitValue))
+            : (Derived.bTrueBelow ? State.Value <= Derived.EnterValue : State.Value >= Derived.EnterValue);
+
+        if (bActive != Derived.bActive)
+        {
+            Derived.bActive = bActive;
+            SetFact(Derived.Fact, Derived.FactIndex, bActive, ChangedFacts);
+        }
+    }
+
+    BroadcastChanges(ChangedFacts);
+}
+
+void UGOAPWorldStateComponent::Apply(const TMap<FName, bool>& Effects)
+{
+    FGOAPPackedState ChangedFacts; // track which facts actually changed
+
+    FGOAPFactRegistry& Registry = FGOAPFactRegistry::Get();
+
+    for (const auto& E : Effects)
+    {
+        const int32 FactIndex = Registry.FindOrAddFact(E.Key);
+        if (FactIndex != INDEX_NONE)
+        {
+            SetFact(E.Key, FactIndex, E.Value, ChangedFacts);
         }
-        else
+    }
+
+    BroadcastChanges(ChangedFacts);
+}
+
+void UGOAPWorldStateComponent::SetFact(FName Name, int32 FactIndex, bool bValue, FGOAPPackedState& ChangedFacts)
+{
+    // Compare against the packed mirror, the map is only touched on a real change
+    bool bExistingValue = false;
+    const bool bKnown = PackedState.GetFact(FactIndex, bExistingValue);
+
+    if (bKnown)
+    {
+        if (bExistingValue != bValue)
         {
-            CurrentState.Bools.Add(E.Key, E.Value);
-            GOAP_WORLDSTATE_LOG(this, EGOAPDebugLevel::Minimal, "WorldState added: %s = %s",
-                *E.Key.ToString(), E.Value ? TEXT("true") : TEXT("false"));
-            bChanged = true;
+            GOAP_WORLDSTATE_LOG(this, EGOAPDebugLevel::Minimal, "WorldState changed: %s = %s",
+                *Name.ToString(), bValue ? TEXT("true") : TEXT("false"));
+            CurrentState.Bools.FindOrAdd(Name) = bValue;
+            PackedState.SetFact(FactIndex, bValue);
+            ChangedFacts.SetFact(FactIndex, bValue);
         }
     }
+    else
+    {
+        CurrentState.Bools.Add(Name, bValue);
+        PackedState.SetFact(FactIndex, bValue);
+        GOAP_WORLDSTATE_LOG(this, EGOAPDebugLevel::Minimal, "WorldState added: %s = %s",
+            *Name.ToString(), bValue ? TEXT("true") : TEXT("false"));
+        ChangedFacts.SetFact(FactIndex, bValue);
+    }
+}
 
-    if (bChanged)
+void UGOAPWorldStateComponent::BroadcastChanges(const FGOAPPackedState& ChangedFacts)
+{
+    if (!ChangedFacts.IsEmpty())
     {
-        OnWorldStateChanged.Broadcast(); // notify the agent that the state has changed
+        OnFactsChanged.Broadcast(this, ChangedFacts); // notify the agent which facts changed
+        OnWorldStateChanged.Broadcast();
     }
 }
 
@@ -5,14 +5,73 @@ UGOAPGoal::UGOAPGoal()
     Priority = 1.0f;
 }
 
+void UGOAPGoal::CompileFacts()
+{
+    const bool bDesiredStateComplete = GOAPPackFacts(DesiredState.Bools, PackedDesiredState);
+    const bool bRelevanceComplete = GOAPPackFacts(RelevanceConditions, PackedRelevanceConditions);
+    bFactsComplete = bDesiredStateComplete && bRelevanceComplete;
+    if (!bFactsComplete)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GOAP] Goal %s uses facts beyond GOAP_MAX_FACTS, it will never be picked."), *GetName());
+    }
+
+    bHasCustomRelevance = bUseCustomRelevance || GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UGOAPGoal, IsRelevant));
+
+    RelevanceMask = FGOAPPackedState();
+    RelevanceMask.AddFacts(PackedRelevanceConditions);
+    if (bHasCustomRelevance && RelevanceFacts.Num() == 0)
+    {
+        // Unknown custom logic, any fact may matter
+        for (int32 W = 0; W < GOAP_FACT_WORDS; ++W)
+        {
+            RelevanceMask.Mask[W] = ~0ull;
+        }
+        return;
+    }
+
+    FGOAPFactRegistry& Registry = FGOAPFactRegistry::Get();
+    for (const FName& Fact : RelevanceFacts)
+    {
+        const int32 FactIndex = Registry.FindOrAddFact(Fact);
+        if (FactIndex != INDEX_NONE)
+        {
+            RelevanceMask.Mask[FactIndex >> 6] |= 1ull << (FactIndex & 63);
+        }
+    }
+}
+
+void UGOAPGoal::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    // Properties (including Blueprint defaults) are final here
+    CompileFacts();
+}
+
+#if WITH_EDITOR
+void UGOAPGoal::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    CompileFacts();
+}
+#endif
+
 // Default name
 FString UGOAPGoal::GetGoalName_Implementation() const
 {
     return GetClass()->GetName();
 }
 
-// Default relevance: always relevant by default
+// Default relevance: every relevance condition holds, always relevant without conditions
 bool UGOAPGoal::IsRelevant_Implementation(const FGOAPWorldState& WorldState) const
 {
+    for (const auto& Pair : RelevanceConditions)
+    {
+        const bool* Value = WorldState.Bools.Find(Pair.Key);
+        if (!Value || *Value != Pair.Value)
+        {
+            return false;
+        }
+    }
     return true;
 }
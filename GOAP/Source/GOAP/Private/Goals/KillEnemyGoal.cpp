@@ -3,17 +3,14 @@
 UGOAPKillEnemyGoal::UGOAPKillEnemyGoal()
 {
     Priority = 10.0f;
+    Urgency = EGOAPUrgency::High;
 
     DesiredState.Bools.Add("EnemyAlive", false);
+    RelevanceConditions.Add("EnemyVisible", true);
+    bUseCustomRelevance = false;
 }
 
 FString UGOAPKillEnemyGoal::GetGoalName_Implementation() const
 {
     return GetClass()->GetName();
 }
-
-bool UGOAPKillEnemyGoal::IsRelevant_Implementation(const FGOAPWorldState& WorldState) const
-{
-    const bool* EnemyVisible = WorldState.Bools.Find("EnemyVisible");
-    return EnemyVisible && *EnemyVisible == true;
-}
\ No newline at end of file
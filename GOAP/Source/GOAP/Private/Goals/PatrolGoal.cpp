@@ -3,17 +3,14 @@
 UGOAPPatrolGoal::UGOAPPatrolGoal()
 {
 	Priority = 1.f;
+	Urgency = EGOAPUrgency::Low;
 
 	DesiredState.Bools.Add("IsPatrolling", true);
+	RelevanceConditions.Add("EnemyVisible", false);
+	bUseCustomRelevance = false;
 }
 
 FString UGOAPPatrolGoal::GetGoalName_Implementation() const
 {
 	return GetClass()->GetName();
 }
-
-bool UGOAPPatrolGoal::IsRelevant_Implementation(const FGOAPWorldState& WorldState) const
-{
-	const bool* EnemyVisible = WorldState.Bools.Find("EnemyVisible");
-	return EnemyVisible && *EnemyVisible == false;
-}
@@ -5,15 +5,11 @@ UGOAPReloadGoal::UGOAPReloadGoal()
 	Priority = 9.0f;
 
 	DesiredState.Bools.Add("HasBullets", true);
+	RelevanceConditions.Add("HasBullets", false);
+	bUseCustomRelevance = false;
 }
 
 FString UGOAPReloadGoal::GetGoalName_Implementation() const
 {
 	return GetClass()->GetName();
 }
-
-bool UGOAPReloadGoal::IsRelevant_Implementation(const FGOAPWorldState& WorldState) const
-{
-	const bool* Bullets = WorldState.Bools.Find("HasBullets");
-	return Bullets && *Bullets == false;
-}
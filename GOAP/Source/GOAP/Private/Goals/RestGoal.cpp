@@ -5,15 +5,11 @@ UGOAPRestGoal::UGOAPRestGoal()
 	Priority = 8.0f;
 
 	DesiredState.Bools.Add("IsExhausted", false);
+	RelevanceConditions.Add("IsExhausted", true);
+	bUseCustomRelevance = false;
 }
 
 FString UGOAPRestGoal::GetGoalName_Implementation() const
 {
 	return GetClass()->GetName();
 }
-
-bool UGOAPRestGoal::IsRelevant_Implementation(const FGOAPWorldState& WorldState) const
-{
-	const bool* Exhausted = WorldState.Bools.Find("IsExhausted");
-	return Exhausted && *Exhausted == true;
-}
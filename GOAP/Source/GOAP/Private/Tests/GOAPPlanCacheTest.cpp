@@ -0,0 +1,68 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GOAPPlanCacheSubsystem.h"
+#include "GOAPPlanner.h"
+#include "Actions/AttackAction.h"
+#include "Actions/PickupWeaponAction.h"
+#include "Actions/ReloadWeaponAction.h"
+
+// Plan cache behaviour for search failures.
+//
+// Only failures that prove a goal unreachable may be cached. A search that ran out of
+// iterations has to be retried, e.g. by an agent with a larger budget.
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGOAPPlanCacheFailureTest, "GOAP.PlanCache.Failures",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGOAPPlanCacheFailureTest::RunTest(const FString& Parameters)
+{
+    UGOAPPlanner* Planner = NewObject<UGOAPPlanner>();
+    UGOAPPlanCacheSubsystem* PlanCache = NewObject<UGOAPPlanCacheSubsystem>();
+
+    const TArray<UGOAPAction*> Actions = {
+        NewObject<UGOAPPickupWeaponAction>(Planner),
+        NewObject<UGOAPAttackAction>(Planner),
+        NewObject<UGOAPReloadWeaponWeaponAction>(Planner) };
+
+    // Killing the enemy takes two actions, one expansion is not enough
+    FGOAPPlanCacheKey Key;
+    Key.Start = GOAPPackFacts({ { "HasWeapon", false }, { "HasBullets", true }, { "EnemyVisible", true }, { "EnemyAlive", true } });
+    Key.Goal = GOAPPackFacts({ { "EnemyAlive", false } });
+    Key.ActionSetSignature = Planner->GetActionSet(Actions).Signature;
+
+    TArray<int32> Plan;
+    bool bReachable = true;
+    EGOAPSearchFailure Failure = EGOAPSearchFailure::None;
+
+    Planner->MaxIterations = 1;
+    const bool bFoundPlan = Planner->PlanIndices(Key.Start, Key.Goal, Actions, Plan, EGOAPDebugLevel::None,
+        EGOAPSearchMode::Forward, EGOAPHeuristic::GoalCount, &Failure);
+    TestFalse(TEXT("Budget-limited search fails"), bFoundPlan);
+    TestTrue(TEXT("Failure is the iteration limit"), Failure == EGOAPSearchFailure::IterationLimit);
+    TestFalse(TEXT("Iteration limit failure is not stored"), PlanCache->AddSearchResult(Key, Plan, bFoundPlan, Failure));
+    TestFalse(TEXT("Iteration limit failure is not found"), PlanCache->Find(Key, Plan, bReachable));
+
+    // With enough budget the same key plans and is cached
+    Planner->MaxIterations = 1000;
+    TestTrue(TEXT("Search with budget succeeds"), Planner->PlanIndices(Key.Start, Key.Goal, Actions, Plan, EGOAPDebugLevel::None,
+        EGOAPSearchMode::Forward, EGOAPHeuristic::GoalCount, &Failure));
+    TestTrue(TEXT("Plan is stored"), PlanCache->AddSearchResult(Key, Plan, true, Failure));
+    TestTrue(TEXT("Plan is found"), PlanCache->Find(Key, Plan, bReachable) && bReachable && Plan.Num() == 2);
+
+    // A goal ruled out by the relaxed heuristic is a proven failure and cached as unreachable
+    FGOAPPlanCacheKey UnreachableKey = Key;
+    UnreachableKey.Goal = GOAPPackFacts({ { "IsPatrolling", true } });
+    UnreachableKey.Heuristic = EGOAPHeuristic::Max;
+    const bool bFoundUnreachable = Planner->PlanIndices(UnreachableKey.Start, UnreachableKey.Goal, Actions, Plan, EGOAPDebugLevel::None,
+        EGOAPSearchMode::Forward, EGOAPHeuristic::Max, &Failure);
+    TestFalse(TEXT("Unreachable goal fails"), bFoundUnreachable);
+    TestTrue(TEXT("Failure is unreachable"), Failure == EGOAPSearchFailure::Unreachable);
+    TestTrue(TEXT("Unreachable failure is stored"), PlanCache->AddSearchResult(UnreachableKey, Plan, bFoundUnreachable, Failure));
+    TestTrue(TEXT("Unreachable failure is found"), PlanCache->Find(UnreachableKey, Plan, bReachable) && !bReachable);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
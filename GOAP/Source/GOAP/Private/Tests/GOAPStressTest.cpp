@@ -0,0 +1,258 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GOAPAgent.h"
+#include "GOAPReplanSubsystem.h"
+#include "Actions/AttackAction.h"
+#include "Actions/PatrolAction.h"
+#include "Actions/PickupWeaponAction.h"
+#include "Actions/PutAwayWeaponAction.h"
+#include "Actions/ReloadWeaponAction.h"
+#include "Actions/RestAction.h"
+#include "Goals/KillEnemyGoal.h"
+#include "Goals/PatrolGoal.h"
+#include "Goals/ReloadGoal.h"
+#include "Goals/RestGoal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+// Crowd-scale planning benchmark.
+//
+// Spawns agents with the stock actions and goals into a fresh game world, ticks it at a fixed
+// step while flipping EnemyVisible and draining stamina on random agents, and writes the
+// measurements to Saved/Automation/GOAP/StressTest_<Agents>.json. Runs headless, e.g.
+//   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests GOAP.Stress;Quit"
+
+namespace GOAPStressTest
+{
+    constexpr int32 NumFrames = 300;
+    constexpr float FrameDeltaSeconds = 1.f / 30.f;
+
+    /** Every ChurnInterval frames, this share of agents gets its enemy visibility flipped and this share gets drained. */
+    constexpr int32 ChurnInterval = 10;
+    constexpr float EnemyChurnFraction = 0.05f;
+    constexpr float ExhaustionChurnFraction = 0.02f;
+
+    /** Value at a percentile of sorted samples, nearest rank. */
+    static double Percentile(const TArray<double>& Sorted, double Fraction)
+    {
+        if (Sorted.Num() == 0)
+        {
+            return 0.0;
+        }
+        const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+        return Sorted[Index];
+    }
+
+    static TSharedRef<FJsonObject> MakeDistribution(TArray<double>& Samples)
+    {
+        Samples.Sort();
+
+        double Sum = 0.0;
+        for (double Sample : Samples)
+        {
+            Sum += Sample;
+        }
+
+        TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+        Json->SetNumberField(TEXT("Count"), Samples.Num());
+        Json->SetNumberField(TEXT("Mean"), Samples.Num() > 0 ? Sum / Samples.Num() : 0.0);
+        Json->SetNumberField(TEXT("P50"), Percentile(Samples, 0.50));
+        Json->SetNumberField(TEXT("P90"), Percentile(Samples, 0.90));
+        Json->SetNumberField(TEXT("P99"), Percentile(Samples, 0.99));
+        Json->SetNumberField(TEXT("Max"), Samples.Num() > 0 ? Samples.Last() : 0.0);
+        return Json;
+    }
+
+    static AGOAPAgent* SpawnStockAgent(UWorld* World, int32 Index)
+    {
+        // Spread the crowd on a grid so collision does not push agents around
+        const FTransform Transform(FVector((Index % 100) * 200.f, (Index / 100) * 200.f, 100.f));
+
+        AGOAPAgent* Agent = World->SpawnActorDeferred<AGOAPAgent>(AGOAPAgent::StaticClass(), Transform,
+            nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        if (!Agent)
+        {
+            return nullptr;
+        }
+
+        Agent->DebugLevel = EGOAPDebugLevel::None;
+        Agent->ActionClasses = {
+            UGOAPAttackAction::StaticClass(),
+            UGOAPPatrolAction::StaticClass(),
+            UGOAPPickupWeaponAction::StaticClass(),
+            UGOAPPutAwayWeaponAction::StaticClass(),
+            UGOAPReloadWeaponWeaponAction::StaticClass(),
+            UGOAPRestAction::StaticClass() };
+        Agent->GoalClasses = {
+            UGOAPKillEnemyGoal::StaticClass(),
+            UGOAPPatrolGoal::StaticClass(),
+            UGOAPReloadGoal::StaticClass(),
+            UGOAPRestGoal::StaticClass() };
+
+        TMap<FName, bool>& Facts = Agent->GetWorldState()->CurrentState.Bools;
+        Facts.Add("HasWeapon", false);
+        Facts.Add("HasBullets", true);
+        Facts.Add("EnemyVisible", false);
+        Facts.Add("EnemyAlive", false);
+        Facts.Add("IsPatrolling", false);
+
+        Agent->FinishSpawning(Transform);
+        return Agent;
+    }
+
+    static bool Run(FAutomationTestBase& Test, int32 NumAgents)
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld*/ false, TEXT("GOAPStressWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        // Actor BeginPlay is dispatched by the game mode, without one the agents would never start
+        World->SetGameMode(FURL());
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+
+        const FPlatformMemoryStats MemoryBefore = FPlatformMemory::GetStats();
+        const double SpawnStart = FPlatformTime::Seconds();
+
+        TArray<AGOAPAgent*> Agents;
+        Agents.Reserve(NumAgents);
+        for (int32 Index = 0; Index < NumAgents; ++Index)
+        {
+            if (AGOAPAgent* Agent = SpawnStockAgent(World, Index))
+            {
+                Agents.Add(Agent);
+            }
+        }
+
+        const double SpawnMs = (FPlatformTime::Seconds() - SpawnStart) * 1e3;
+        const FPlatformMemoryStats MemoryAfter = FPlatformMemory::GetStats();
+        Test.TestEqual(TEXT("Spawned agents"), Agents.Num(), NumAgents);
+
+        TArray<int32> SeenPlanCalls;
+        SeenPlanCalls.Init(0, Agents.Num());
+        TArray<double> PlanMicroseconds;
+        TArray<double> FrameMilliseconds;
+        FrameMilliseconds.Reserve(NumFrames);
+        int32 PeakQueueDepth = 0;
+
+        FRandomStream Random(NumAgents);
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            if (Frame % ChurnInterval == 0)
+            {
+                for (AGOAPAgent* Agent : Agents)
+                {
+                    if (Random.FRand() < EnemyChurnFraction)
+                    {
+                        const bool* bVisible = Agent->GetWorldState()->CurrentState.Bools.Find("EnemyVisible");
+                        Agent->SetEnemyVisible(!(bVisible && *bVisible));
+                    }
+                    if (Random.FRand() < ExhaustionChurnFraction)
+                    {
+                        Agent->GetWorldState()->SetChannelValue(Agent->GetStaminaChannelIndex(), 0.f);
+                    }
+                }
+            }
+
+            const double FrameStart = FPlatformTime::Seconds();
+            World->Tick(LEVELTICK_All, FrameDeltaSeconds);
+            FrameMilliseconds.Add((FPlatformTime::Seconds() - FrameStart) * 1e3);
+
+            // One sample per agent that planned this frame
+            for (int32 Index = 0; Index < Agents.Num(); ++Index)
+            {
+                const int32 PlanCalls = Agents[Index]->GetNumPlanCalls();
+                if (PlanCalls != SeenPlanCalls[Index])
+                {
+                    SeenPlanCalls[Index] = PlanCalls;
+                    PlanMicroseconds.Add(Agents[Index]->GetLastPlanMicroseconds());
+                }
+            }
+
+            if (UGOAPReplanSubsystem* Scheduler = World->GetSubsystem<UGOAPReplanSubsystem>())
+            {
+                PeakQueueDepth = FMath::Max(PeakQueueDepth, Scheduler->GetTotalQueueDepth());
+            }
+        }
+
+        int32 TotalPlanCalls = 0;
+        for (const AGOAPAgent* Agent : Agents)
+        {
+            TotalPlanCalls += Agent->GetNumPlanCalls();
+        }
+        const double SimulatedSeconds = NumFrames * FrameDeltaSeconds;
+
+        // Every agent plans at least once after BeginPlay, otherwise the numbers measure empty frames
+        Test.TestTrue(TEXT("Agents planned"), TotalPlanCalls >= NumAgents);
+
+        TSharedRef<FJsonObject> Results = MakeShared<FJsonObject>();
+        Results->SetStringField(TEXT("Test"), TEXT("GOAP.Stress"));
+        Results->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+        Results->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+        Results->SetStringField(TEXT("BuildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+        Results->SetNumberField(TEXT("Agents"), Agents.Num());
+        Results->SetNumberField(TEXT("Frames"), NumFrames);
+        Results->SetNumberField(TEXT("FrameDeltaSeconds"), FrameDeltaSeconds);
+        Results->SetNumberField(TEXT("SpawnMs"), SpawnMs);
+        Results->SetNumberField(TEXT("PlanCalls"), TotalPlanCalls);
+        Results->SetNumberField(TEXT("ReplansPerSecond"), TotalPlanCalls / SimulatedSeconds);
+        Results->SetNumberField(TEXT("PeakReplanQueueDepth"), PeakQueueDepth);
+        Results->SetObjectField(TEXT("PlanMicroseconds"), MakeDistribution(PlanMicroseconds));
+        Results->SetObjectField(TEXT("GameThreadFrameMs"), MakeDistribution(FrameMilliseconds));
+
+        const double UsedBytes = (double)MemoryAfter.UsedPhysical - (double)MemoryBefore.UsedPhysical;
+        Results->SetNumberField(TEXT("SpawnUsedPhysicalBytes"), UsedBytes);
+        Results->SetNumberField(TEXT("SpawnUsedPhysicalBytesPerAgent"), Agents.Num() > 0 ? UsedBytes / Agents.Num() : 0.0);
+        Results->SetNumberField(TEXT("PeakUsedPhysicalBytes"), (double)FPlatformMemory::GetStats().PeakUsedPhysical);
+
+        FString Output;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+        FJsonSerializer::Serialize(Results, Writer);
+
+        const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("GOAP"),
+            FString::Printf(TEXT("StressTest_%d.json"), NumAgents));
+        Test.TestTrue(TEXT("Results written"), FFileHelper::SaveStringToFile(Output, *FilePath));
+        Test.AddInfo(FString::Printf(TEXT("%d agents: %d plans, frame P50 %.2f ms, results in %s"),
+            Agents.Num(), TotalPlanCalls, Percentile(FrameMilliseconds, 0.5), *FilePath));
+
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(/*bInformEngineOfWorld*/ false);
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGOAPStressTest100, "GOAP.Stress.Agents100",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FGOAPStressTest100::RunTest(const FString& Parameters)
+{
+    return GOAPStressTest::Run(*this, 100);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGOAPStressTest1000, "GOAP.Stress.Agents1000",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FGOAPStressTest1000::RunTest(const FString& Parameters)
+{
+    return GOAPStressTest::Run(*this, 1000);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGOAPStressTest5000, "GOAP.Stress.Agents5000",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::StressFilter)
+
+bool FGOAPStressTest5000::RunTest(const FString& Parameters)
+{
+    return GOAPStressTest::Run(*this, 5000);
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "GOAPTypes.h"
 #include "GOAPAction.generated.h"
 
 class AGOAPAgent;
@@ -56,6 +57,27 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
     TMap<FName, bool> Effects;
 
+    /**
+     * @brief Rebuilds the packed preconditions and effects from the TMap properties.
+     *
+     * Called automatically after construction and editor changes. Call it manually
+     * after changing @ref Preconditions or @ref Effects at runtime.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    void CompileFacts();
+
+    /** @return The bit-packed form of @ref Preconditions used by the planner. */
+    const FGOAPPackedState& GetPackedPreconditions() const { return PackedPreconditions; }
+
+    /** @return The bit-packed form of @ref Effects used by the planner. */
+    const FGOAPPackedState& GetPackedEffects() const { return PackedEffects; }
+
+    /**
+     * @return False if a fact of @ref Preconditions or @ref Effects did not fit into the fact
+     * registry. The packed data is then incomplete and the action is never planned with.
+     */
+    bool HasCompleteFacts() const { return bFactsComplete; }
+
     /**
      * @brief The actions cost value.
      *
@@ -124,4 +146,20 @@ public:
      */
     UFUNCTION(BlueprintNativeEvent, Category = "GOAP")
     void OnInterrupt(AGOAPAgent* Agent);
+
+    virtual void PostInitProperties() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+    /** Packed copy of @ref Preconditions. */
+    FGOAPPackedState PackedPreconditions;
+
+    /** Packed copy of @ref Effects. */
+    FGOAPPackedState PackedEffects;
+
+    /** Whether every fact was packed by the last @ref CompileFacts. */
+    bool bFactsComplete = true;
 };
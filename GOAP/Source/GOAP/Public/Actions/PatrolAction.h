@@ -17,4 +17,8 @@ public:
     virtual void TickAction_Implementation(float DeltaTime, AGOAPAgent* agent);
 
     virtual void OnInterrupt_Implementation(AGOAPAgent* Agent);
+
+private:
+    /** World time before which no new patrol point is picked, see FGOAPLODSettings::PatrolRetargetInterval. */
+    double NextRetargetTime = 0.0;
 };
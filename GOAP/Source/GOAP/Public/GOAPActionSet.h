@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GOAPTypes.h"
+#include "GOAPCore/ActionSet.h"
+
+class UGOAPAction;
+
+/// \file GOAPActionSet.h
+
+/**
+ * @brief Flat, immutable planning data for a list of actions.
+ *
+ * The data and queries live in GOAPCore::FActionSet, this adds building it from UObject
+ * actions. Action indices match the index in the list the set was built from.
+ */
+struct GOAP_API FGOAPActionSet : public GOAPCore::FActionSet
+{
+    /**
+     * @brief Compiles the planning data of a list of actions.
+     *
+     * @param Actions The actions, null entries are allowed and never planned with.
+     */
+    void Build(const TArray<UGOAPAction*>& Actions);
+
+    /**
+     * @brief Checks if this set was built from exactly these actions and their current data.
+     *
+     * @param Actions The action list to compare with.
+     * @return True if the set can be used to plan with these actions.
+     */
+    bool IsUpToDate(const TArray<UGOAPAction*>& Actions) const;
+
+    /**
+     * @brief Simulates a plan to check it still reaches the goal.
+     *
+     * @param Start The state the plan would start from.
+     * @param Goal The goal the plan has to reach.
+     * @param ActionIndices The plan, in execution order.
+     * @return True if every action's preconditions hold when it runs and the final state satisfies the goal.
+     */
+    bool IsPlanValid(const FGOAPPackedState& Start, const FGOAPPackedState& Goal, TConstArrayView<int32> ActionIndices) const
+    {
+        return GOAPCore::FActionSet::IsPlanValid(Start, Goal, ActionIndices.GetData(), ActionIndices.Num());
+    }
+};
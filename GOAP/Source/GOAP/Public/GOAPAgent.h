@@ -9,6 +9,7 @@
 #include "GOAPAgent.generated.h"
 
 class UGOAPAction;
+class UGOAPDomain;
 
 /**
  * @brief GOAP Agent responsible for managing goals, actions, and planning.
@@ -33,6 +34,15 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GOAP")
     UGOAPWorldStateComponent* WorldState;
 
+    /**
+     * @brief Shared actions and goals of this agent's archetype, used instead of @ref ActionClasses and @ref GoalClasses.
+     *
+     * Agents using a domain share its compiled planning data and goal defaults, and only
+     * instantiate an action the first time they execute it.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GOAP")
+    UGOAPDomain* Domain = nullptr;
+
     /**
      * @brief List of action classes available to this agent.
      *
@@ -44,6 +54,8 @@ protected:
 
     /**
      * @brief Instantiated action objects created from @ref ActionClasses.
+     *
+     * With a @ref Domain, holds one entry per domain action that stays null until the action first runs.
      */
     UPROPERTY()
     TArray<UGOAPAction*> AvailableActions;
@@ -59,6 +71,8 @@ protected:
 
     /**
      * @brief Instantiated goal objects derived from @ref GoalClasses.
+     *
+     * With a @ref Domain, the domain's shared goal defaults.
      */
     UPROPERTY()
     TArray<UGOAPGoal*> AvailableGoals;
@@ -73,9 +87,38 @@ public:
     /** Called when the game starts or the actor is spawned. */
     virtual void BeginPlay() override;
 
+    /** Called when the actor is removed, cancels a pending async plan. */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /** Called every frame. */
     virtual void Tick(float DeltaTime) override;
 
+    /**
+     * @brief Stops planning and acting, called when the agent is returned to a pool.
+     *
+     * The planner, actions and goals are kept for the next use. See UGOAPAgentPoolSubsystem.
+     */
+    virtual void OnReleasedToPool();
+
+    /**
+     * @brief Resets the world state and requests a first plan, called when the agent is taken from a pool.
+     */
+    virtual void OnAcquiredFromPool();
+
+    /** @return True while the agent sits unused in a pool. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    bool IsInPool() const { return bInPool; }
+
+    /**
+     * @brief Hides the agent and turns off its collision and ticking, or turns them back on.
+     *
+     * Used by UGOAPAgentPoolSubsystem, and by BeginPlay for agents released before play began,
+     * whose ticks BeginPlay would otherwise enable again.
+     *
+     * @param bPooled True to park the agent, false to bring it back.
+     */
+    void ApplyPooledState(bool bPooled);
+
     /**
      * @brief Returns a string representation of the current world state.
      *
@@ -126,6 +169,60 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GOAP")
     void ExecutePlan();
 
+    /**
+     * @brief The goal @ref CurrentPlan was made for.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "GOAP")
+    UGOAPGoal* CurrentGoal = nullptr;
+
+    /**
+     * @brief Whether world state changes to facts the agent does not depend on are ignored.
+     *
+     * See @ref GetRelevanceMask for the facts that trigger a replan.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bFilterIrrelevantFacts = true;
+
+    /**
+     * @brief Returns the facts whose change makes the agent replan.
+     *
+     * The union of the relevance facts of every goal, the current goal's desired facts and
+     * the preconditions of the remaining plan. Every fact while there is no plan.
+     *
+     * @return A packed state whose mask holds the relevant facts.
+     */
+    FGOAPPackedState GetRelevanceMask() const;
+
+    /**
+     * @brief Whether a requested replan first checks if the current plan still works.
+     *
+     * When the remaining plan still reaches @ref CurrentGoal from the new state and no
+     * more important goal became relevant, the agent keeps executing it without planning.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bValidatePlanBeforeReplan = true;
+
+    /**
+     * @brief Checks if the current plan can keep running in the current world state.
+     *
+     * Simulates the remaining actions on the packed state and reruns goal selection.
+     *
+     * @return True if every remaining action is still applicable in turn, the plan still
+     *         reaches @ref CurrentGoal, and that goal is still the one goal selection picks.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    bool IsCurrentPlanValid();
+
+    /**
+     * @brief Picks the goal to plan for: the highest priority relevant goal, or the lowest
+     * priority goal if none is relevant.
+     *
+     * Goals stay sorted between calls and are only re-sorted after a priority changes.
+     *
+     * @return The selected goal, or null if the agent has no goals.
+     */
+    UGOAPGoal* SelectGoal();
+
     /**
      * @brief The action currently being executed by the agent.
      */
@@ -133,12 +230,17 @@ public:
     UGOAPAction* CurrentAction;
 
     /**
-     * @brief The agents maximum stamina or energy capacity.
+     * @brief Name of the world state channel holding the agents stamina.
      *
-     * A value of 100 represents fully rested.
+     * The default channel runs from 0 to 100, where 100 represents fully rested. It sets
+     * IsExhausted once it is drained and clears it again once it is full. Overriding the name
+     * renames the default channel in BeginPlay, a warning is logged if no channel matches.
      */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
-    float ExhaustionLimit = 100.f;
+    FName StaminaChannel = "Stamina";
+
+    /** @return The world state channel index of @ref StaminaChannel, or INDEX_NONE. */
+    int32 GetStaminaChannelIndex() const { return StaminaChannelIndex; }
 
     /**
      * @brief How quickly the agent becomes tired while performing actions.
@@ -182,6 +284,164 @@ public:
      */
     bool bRequestReplan = false;
 
+    /**
+     * @brief How the planner searches for plans, unless the selected goal overrides it.
+     *
+     * Forward search expands every applicable action from the current state. Regressive
+     * search starts from the goal and only considers actions that achieve an open subgoal.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward;
+
+    /**
+     * @brief The estimate that guides the planner's search.
+     *
+     * The relaxed heuristics take action costs into account and need far fewer expansions
+     * on deep domains. Relaxed Max keeps plans optimal, Relaxed Add and FF guide best but
+     * may return a slightly more expensive plan.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    EGOAPHeuristic PlanHeuristic = EGOAPHeuristic::GoalCount;
+
+    /**
+     * @brief Whether plans are looked up in and stored to the world's shared plan cache.
+     *
+     * Agents with the same actions reuse each other's plans for the same state and goal.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bUsePlanCache = true;
+
+    /**
+     * @brief Whether replans go through the world's replan scheduler.
+     *
+     * The scheduler plans queued agents within a per-frame budget, most urgent first.
+     * Without it the agent plans as soon as its reaction timer runs out.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bUseReplanScheduler = true;
+
+    /**
+     * @brief Whether the agent plans for all relevant goals in one search instead of the selected goal only.
+     *
+     * The planner picks, among the goals it can reach, the one with the best priority minus
+     * weighted plan cost, so an unreachable goal falls back to the next one within the same
+     * search. Falls back to every goal when none is relevant. Always searches forward with
+     * the Relaxed Max heuristic instead of @ref PlanHeuristic: the utility bound is only exact
+     * with an admissible estimate, and under Goal Count an unreachable top goal would use up
+     * the whole iteration limit before a lower goal is tried. Does not use the plan cache.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bPlanMultiGoal = false;
+
+    /**
+     * @brief Priority lost per unit of plan cost when multi-goal planning compares goals.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (ClampMin = "0", EditCondition = "bPlanMultiGoal"))
+    float PlanCostWeight = 0.1f;
+
+    /**
+     * @brief Returns the urgency class of a replan for this agent.
+     *
+     * @return The highest @ref UGOAPGoal::Urgency among the goals relevant right now.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    EGOAPUrgency GetReplanUrgency() const;
+
+    /**
+     * @brief Whether plans are searched on a worker thread instead of inside Tick.
+     *
+     * The current action keeps running while the search runs. The result is checked against
+     * the world state it arrives in before it is executed, and is dropped if a newer replan
+     * was requested in the meantime.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bPlanAsync = false;
+
+    /**
+     * @brief Whether plans are searched a few nodes per frame instead of all at once.
+     *
+     * Used when @ref bPlanAsync is off. The search keeps its state between frames and
+     * the current action keeps running until it finishes.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bTimeSlicePlanning = false;
+
+    /**
+     * @brief Whether time-sliced searches run in anytime mode.
+     *
+     * The search first finds a plan quickly with an inflated heuristic, which the agent starts
+     * executing right away, then keeps refining it over the next frames. A better plan replaces
+     * the current one until the first action of the plan has finished. Anytime results are not
+     * stored in the plan cache.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (EditCondition = "bTimeSlicePlanning"))
+    bool bPlanAnytime = false;
+
+    /**
+     * @brief Heuristic inflation of the first anytime pass, higher finds the first plan sooner.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (ClampMin = "1", EditCondition = "bPlanAnytime"))
+    float AnytimeInitialWeight = 3.f;
+
+    /**
+     * @brief Maximum number of nodes a time-sliced search expands per frame.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (ClampMin = "1", EditCondition = "bTimeSlicePlanning"))
+    int32 PlanExpansionsPerTick = 256;
+
+    /**
+     * @brief Time a time-sliced search may spend per frame, in microseconds. Zero for no time limit.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (ClampMin = "0", EditCondition = "bTimeSlicePlanning"))
+    float PlanMicrosecondsPerTick = 250.f;
+
+    /**
+     * @brief Maximum number of node expansions before the planner gives up on a goal.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (ClampMin = "1"))
+    int32 MaxPlanIterations = 5000;
+
+    /**
+     * @brief Whether the world's LOD subsystem scales this agent's ticking and planning, read in BeginPlay.
+     *
+     * See UGOAPLODSubsystem. Off by default, the agent then always runs at full detail and
+     * keeps its own budgets, which a lower level would otherwise cut.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP|LOD")
+    bool bUseLOD = false;
+
+    /** @return The level of detail the agent currently runs at. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|LOD")
+    EGOAPLOD GetLOD() const { return LOD; }
+
+    /** @return The settings of the current level of detail. */
+    const FGOAPLODSettings& GetLODSettings() const { return LODSettings; }
+
+    /**
+     * @brief Switches the agent to a level of detail, called by UGOAPLODSubsystem.
+     *
+     * Applies the tick interval, planning budget and heuristic weight of the level. Going
+     * dormant drops a queued or running search, the agent replans once it is woken up.
+     *
+     * @param NewLOD The level to run at.
+     * @param Settings The settings of that level.
+     */
+    void SetLOD(EGOAPLOD NewLOD, const FGOAPLODSettings& Settings);
+
+    /** @return Number of @ref PlanActions calls since the agent was spawned. */
+    int32 GetNumPlanCalls() const { return NumPlanCalls; }
+
+    /**
+     * @return Time the last @ref PlanActions call spent on the game thread, in microseconds.
+     *
+     * Async and time-sliced searches only count the part that ran inside the call.
+     */
+    double GetLastPlanMicroseconds() const { return LastPlanMicroseconds; }
+
+    /** @return True while an async or time-sliced search is running. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    bool IsPlanPending() const { return PendingPlanRequest.IsValid() || bTimeSlicedPlanPending; }
+
     /**
      * @brief Controls how much debugging information is logged or displayed.
      *
@@ -189,4 +449,92 @@ public:
      */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP|Debug")
     EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::Minimal;
+
+private:
+    /** Counters behind @ref GetNumPlanCalls and @ref GetLastPlanMicroseconds. */
+    int32 NumPlanCalls = 0;
+    double LastPlanMicroseconds = 0.0;
+
+    /** Whether the agent sits unused in a pool. */
+    bool bInPool = false;
+
+    /** Current level of detail and its settings, full detail until the LOD subsystem says otherwise. */
+    EGOAPLOD LOD = EGOAPLOD::High;
+    FGOAPLODSettings LODSettings;
+
+    /** Cached index of @ref StaminaChannel, resolved in BeginPlay. */
+    int32 StaminaChannelIndex = INDEX_NONE;
+
+    /** @return The actions plans are made from, the domain's shared defaults if there is a @ref Domain. */
+    const TArray<UGOAPAction*>& GetPlanningActions() const { return Domain ? DomainActions : AvailableActions; }
+
+    /** Returns this agent's instance of a planned action, creating it on first use with a @ref Domain. */
+    UGOAPAction* GetActionInstance(int32 ActionIndex);
+
+    /** The domain's action defaults, cached in BeginPlay. */
+    UPROPERTY()
+    TArray<UGOAPAction*> DomainActions;
+
+    /** Sorts @ref AvailableGoals by descending priority unless they already are. */
+    void SortGoalsIfNeeded();
+
+    /** Requests a replan if one of the changed facts is relevant to this agent. */
+    void OnWorldFactsChanged(UGOAPWorldStateComponent* Component, const FGOAPPackedState& ChangedFacts);
+
+    /** Accepts a finished async search unless it was superseded. */
+    void OnAsyncPlanComplete(const FGOAPAsyncPlanRequestRef& Request);
+
+    /** Advances the time-sliced search by one frame's budget and accepts its result once done. */
+    void StepTimeSlicedPlan();
+
+    /** Steps the planner's search with this frame's budget, scaled by the level of detail. */
+    EGOAPSearchStatus StepPlanSlice();
+
+    /** Advances the anytime search, executing each better plan it publishes. */
+    void StepAnytimePlan();
+
+    /** Executes a plan published by the anytime search, or swaps it in for the previous one. */
+    void AcceptAnytimePlan(const FGOAPPlanSearch& Search);
+
+    /** Validates the result of an async or time-sliced search against the current state and executes it. */
+    void AcceptDeferredPlan(const FGOAPActionSet& PlannedSet, const FGOAPPackedState& PlannedStart, const FGOAPPackedState& PlannedGoal,
+        EGOAPSearchMode PlannedSearchMode, EGOAPHeuristic PlannedHeuristic, float PlannedHeuristicWeight, const TArray<int32>& ActionIndices, bool bFoundPlan,
+        EGOAPSearchFailure Failure, int32 PlannedGoalIndex = INDEX_NONE);
+
+    /** Plans for every candidate goal in one search, see @ref bPlanMultiGoal. */
+    void PlanMultiGoal();
+
+    /** Starts the plan of a multi-goal search and remembers the candidates it passed over. */
+    void StartMultiGoalPlan(const TArray<UGOAPGoal*>& Candidates, int32 GoalIndex, const TArray<int32>& ActionIndices, bool bFoundPlan);
+
+    /** Cancels the pending async or time-sliced search, if any. */
+    void CancelPendingPlan();
+
+    /** Interrupts the running action and clears @ref CurrentPlan. */
+    void StopCurrentPlan();
+
+    /** Replaces the current plan with the actions at the given indices and starts executing it. */
+    void StartPlan(const TArray<int32>& ActionIndices, bool bFoundPlan, UGOAPGoal* Goal);
+
+    /** The async search in flight, superseded requests are cancelled. */
+    TSharedPtr<FGOAPAsyncPlanRequest, ESPMode::ThreadSafe> PendingPlanRequest;
+
+    /** Whether the planner's search was started by a time-sliced replan and is still running. */
+    bool bTimeSlicedPlanPending = false;
+
+    /** Number of anytime plans already taken from the pending search. */
+    int32 AnytimePlansAccepted = 0;
+
+    /** Length of the last anytime plan started, a shorter @ref CurrentPlan means its first action finished. */
+    int32 AnytimePlanLength = 0;
+
+    /** The goal the pending async or time-sliced search plans for. */
+    TWeakObjectPtr<UGOAPGoal> PendingPlanGoal;
+
+    /** The candidates of a pending multi-goal search, in the order passed to the planner. */
+    TArray<TWeakObjectPtr<UGOAPGoal>> PendingGoalCandidates;
+
+    /** Candidates ranked above @ref CurrentGoal that the multi-goal search passed over. */
+    UPROPERTY()
+    TArray<UGOAPGoal*> SkippedGoals;
 };
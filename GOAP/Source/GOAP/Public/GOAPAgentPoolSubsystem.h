@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GOAPAgentPoolSubsystem.generated.h"
+
+class AGOAPAgent;
+
+/**
+ * @brief Number of agents of one class to create when a level starts.
+ */
+USTRUCT(BlueprintType)
+struct GOAP_API FGOAPAgentPrewarm
+{
+    GENERATED_BODY()
+
+    /** The agent class to create. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GOAP|Pool")
+    TSoftClassPtr<AGOAPAgent> AgentClass;
+
+    /** How many agents of the class to create. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GOAP|Pool", meta = (ClampMin = "0"))
+    int32 Count = 0;
+};
+
+/** The unused agents of one class. */
+USTRUCT()
+struct FGOAPAgentPool
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<AGOAPAgent*> Agents;
+};
+
+/**
+ * @brief World-level pool that recycles GOAP agents instead of destroying and respawning them.
+ *
+ * A released agent keeps its planner, actions, goals and compiled planning data. It is
+ * hidden, stops ticking and acting, and gets its world state reset when it is acquired
+ * again, so spawning a wave from the pool costs no allocations and no BeginPlay work.
+ * Agents can be created ahead of time with @ref PrewarmAgents or the configured
+ * @ref Prewarm list, which is spawned when the level starts.
+ */
+UCLASS(config = Game)
+class GOAP_API UGOAPAgentPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * @brief Takes an agent of a class from the pool, spawning one if the pool is empty.
+     *
+     * The agent is moved to the transform, shown, ticks again and requests its first plan.
+     *
+     * @param AgentClass The agent class.
+     * @param Transform Where to place the agent.
+     * @return The agent, or null if it could not be spawned.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Pool")
+    AGOAPAgent* AcquireAgent(TSubclassOf<AGOAPAgent> AgentClass, const FTransform& Transform);
+
+    /**
+     * @brief Returns an agent to the pool instead of destroying it.
+     *
+     * @param Agent The agent to release, ignored if it already is in the pool.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Pool")
+    void ReleaseAgent(AGOAPAgent* Agent);
+
+    /**
+     * @brief Spawns agents into the pool until it holds at least Count of the class.
+     *
+     * @param AgentClass The agent class.
+     * @param Count The number of unused agents to have ready.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Pool")
+    void PrewarmAgents(TSubclassOf<AGOAPAgent> AgentClass, int32 Count);
+
+    /** @return Number of unused agents of a class in the pool. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Pool")
+    int32 GetNumPooled(TSubclassOf<AGOAPAgent> AgentClass) const;
+
+    /**
+     * @brief Agents to spawn into the pool when the level starts.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|Pool")
+    TArray<FGOAPAgentPrewarm> Prewarm;
+
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Spawns a new agent, outside the pool. */
+    AGOAPAgent* SpawnAgent(TSubclassOf<AGOAPAgent> AgentClass, const FTransform& Transform);
+
+    /** Unused agents per class. */
+    UPROPERTY()
+    TMap<TSubclassOf<AGOAPAgent>, FGOAPAgentPool> Pools;
+};
@@ -19,6 +19,9 @@ enum class EGOAPDebugLevel : uint8
     /** Only essential or key events are logged (e.g., replans, action completions). */
     Minimal UMETA(DisplayName = "Minimal"),
 
-    /** Detailed logs including planner steps, world state changes, and internal reasoning. */
+    /**
+     * Detailed logs including world state changes and internal reasoning. Planner steps are
+     * recorded into a binary trace instead of the log, see UGOAPPlanner::DumpPlannerTrace.
+     */
     Detailed UMETA(DisplayName = "Detailed")
 };
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GOAPActionSet.h"
+#include "GOAPDomain.generated.h"
+
+class UGOAPAction;
+class UGOAPGoal;
+
+/**
+ * @brief The actions and goals of an agent archetype, compiled once and shared by every agent using it.
+ *
+ * Planning only reads the class defaults of the actions and goals, so the domain compiles
+ * them into one immutable FGOAPActionSet that all planners share. Agents then no longer
+ * construct an action and goal object each: goals are shared as read-only defaults and an
+ * action is only instantiated for an agent the first time that agent executes it.
+ */
+UCLASS(BlueprintType)
+class GOAP_API UGOAPDomain : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * @brief The actions of the archetype. Plans refer to them by their index in this list.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GOAP")
+    TArray<TSubclassOf<UGOAPAction>> ActionClasses;
+
+    /**
+     * @brief The goals of the archetype.
+     *
+     * Agents share the class defaults, so goal properties must not be changed per agent at runtime.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GOAP")
+    TArray<TSubclassOf<UGOAPGoal>> GoalClasses;
+
+    /**
+     * @brief Returns the class defaults of @ref ActionClasses, compiling the domain on first use.
+     *
+     * Null classes keep a null entry so indices match @ref ActionClasses.
+     */
+    const TArray<UGOAPAction*>& GetActions();
+
+    /** @brief Returns the class defaults of @ref GoalClasses, compiling the domain on first use. */
+    const TArray<UGOAPGoal*>& GetGoals();
+
+    /** @brief Returns the compiled planning data of @ref ActionClasses, compiling the domain on first use. */
+    TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe> GetActionSet();
+
+    /**
+     * @brief Creates the runtime instance of an action for one agent.
+     *
+     * @param ActionIndex Index into @ref ActionClasses.
+     * @param Outer The owner of the new action, usually the agent.
+     * @return The new action, or null for an invalid index or class.
+     */
+    UGOAPAction* CreateAction(int32 ActionIndex, UObject* Outer) const;
+
+    /**
+     * @brief Recompiles the domain from the current class defaults.
+     *
+     * Only needed if the class defaults were changed at runtime.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    void Compile();
+
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    /** Compiles the domain unless it already is. */
+    void CompileIfNeeded();
+
+    UPROPERTY(Transient)
+    TArray<UGOAPAction*> ActionDefaults;
+
+    UPROPERTY(Transient)
+    TArray<UGOAPGoal*> GoalDefaults;
+
+    /** Compiled from @ref ActionDefaults, replaced rather than rebuilt so planners holding it stay valid. */
+    TSharedPtr<const FGOAPActionSet, ESPMode::ThreadSafe> ActionSet;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+// GOAP_MAX_FACTS and GOAP_FACT_WORDS come from the planning core, the limit can still be set through PublicDefinitions
+#include "GOAPCore/Types.h"
+
+/// \file GOAPFactRegistry.h
+
+/**
+ * @brief Global registry that interns fact names into dense indices.
+ *
+ * Facts referenced by native actions and goals are registered when the module starts up.
+ * Facts that only show up later (Blueprint classes, runtime world state edits) are added
+ * on first use. Indices are stable for the lifetime of the process.
+ */
+class GOAP_API FGOAPFactRegistry
+{
+public:
+    /** @return The process-wide registry instance. */
+    static FGOAPFactRegistry& Get();
+
+    /**
+     * @brief Returns the index of a fact, registering it if it has not been seen yet.
+     *
+     * @param Fact The fact name (e.g. "HasWeapon").
+     * @return The dense index of the fact, or INDEX_NONE if the registry is full.
+     */
+    int32 FindOrAddFact(FName Fact);
+
+    /**
+     * @brief Returns the index of an already registered fact.
+     *
+     * @param Fact The fact name to look up.
+     * @return The dense index of the fact, or INDEX_NONE if it was never registered.
+     */
+    int32 FindFact(FName Fact) const;
+
+    /**
+     * @brief Returns the name of a registered fact.
+     *
+     * @param Index A dense fact index.
+     * @return The fact name, or NAME_None if the index is not registered.
+     */
+    FName GetFactName(int32 Index) const;
+
+    /** @return The number of registered facts. */
+    int32 Num() const;
+
+    /**
+     * @brief Registers every fact used by the loaded native action and goal classes.
+     *
+     * Called once from module startup so that the common facts get low, stable indices.
+     */
+    void RegisterFactsFromLoadedClasses();
+
+private:
+    /** Name to index lookup. */
+    TMap<FName, int32> FactToIndex;
+
+    /** Index to name lookup. */
+    TArray<FName> IndexToFact;
+
+    /** Guards both lookups, planning may read them from worker threads. */
+    mutable FRWLock Lock;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GOAPTypes.h"
+#include "GOAPLODSubsystem.generated.h"
+
+class AGOAPAgent;
+
+/** Picks the level of detail of an agent instead of its distance to the views. */
+DECLARE_DELEGATE_RetVal_OneParam(EGOAPLOD, FGOAPLODSelector, const AGOAPAgent*);
+
+/**
+ * @brief World-level significance manager that scales how much thinking each agent gets.
+ *
+ * Every @ref UpdateInterval the subsystem sorts the registered agents into levels of detail
+ * by their distance to the nearest player view, or by the selector set with @ref SetLODSelector.
+ * Each level scales the agent's tick interval, reaction time, planning budget, heuristic
+ * weight and patrol re-target interval, see FGOAPLODSettings. Dormant agents do not plan
+ * at all until they come back into range.
+ *
+ * Without a view and a selector, for example on a server without players, every agent stays at High.
+ */
+UCLASS(config = Game)
+class GOAP_API UGOAPLODSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UGOAPLODSubsystem();
+
+    /**
+     * @brief Adds an agent to the LOD updates, it keeps its current level until the next one.
+     *
+     * @param Agent The agent to manage.
+     */
+    void RegisterAgent(AGOAPAgent* Agent);
+
+    /**
+     * @brief Removes an agent from the LOD updates, for example when it is destroyed.
+     *
+     * @param Agent The agent to remove.
+     */
+    void UnregisterAgent(AGOAPAgent* Agent);
+
+    /**
+     * @brief Picks and applies the level of one agent right away, e.g. after it was moved.
+     *
+     * @param Agent The agent to update.
+     */
+    void UpdateAgent(AGOAPAgent* Agent);
+
+    /**
+     * @brief Replaces the distance based selection with a callback, unbind it to go back.
+     *
+     * @param InSelector Returns the level of an agent, called once per agent and update.
+     */
+    void SetLODSelector(FGOAPLODSelector InSelector) { Selector = MoveTemp(InSelector); }
+
+    /** @return The settings of a level. */
+    const FGOAPLODSettings& GetLODSettings(EGOAPLOD LOD) const;
+
+    /** @return Number of registered agents at a level after the last update. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|LOD")
+    int32 GetNumAgentsAtLOD(EGOAPLOD LOD) const;
+
+    /** @brief Seconds between two LOD updates of all agents. */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|LOD", meta = (ClampMin = "0"))
+    float UpdateInterval = 0.25f;
+
+    /**
+     * @brief How far past a level's MaxDistance an agent must be before it drops to a lower level, in cm.
+     *
+     * Keeps agents walking along a boundary from switching levels every update.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|LOD", meta = (ClampMin = "0"))
+    float Hysteresis = 500.f;
+
+    /** @brief Settings of agents close to a view. */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|LOD")
+    FGOAPLODSettings HighLOD;
+
+    /** @brief Settings of agents at mid range. */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|LOD")
+    FGOAPLODSettings MediumLOD;
+
+    /** @brief Settings of distant agents. */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|LOD")
+    FGOAPLODSettings LowLOD;
+
+    /** @brief Settings of agents beyond the Low range, which do not plan. */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|LOD")
+    FGOAPLODSettings DormantLOD;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual void Deinitialize() override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Collects the view locations of the local players. */
+    void GatherViewLocations();
+
+    /** @return The level an agent should be at, given its current one. */
+    EGOAPLOD SelectLOD(const AGOAPAgent& Agent) const;
+
+    /** @return The level for a distance to the nearest view. */
+    EGOAPLOD GetLODForDistance(float Distance) const;
+
+    /** Agents to update, destroyed ones are dropped during the next update. */
+    TArray<TWeakObjectPtr<AGOAPAgent>> Agents;
+
+    /** View locations of the current update. */
+    TArray<FVector> ViewLocations;
+
+    FGOAPLODSelector Selector;
+
+    float TimeUntilUpdate = 0.f;
+
+    int32 NumAgentsAtLOD[(int32)EGOAPLOD::Num] = {};
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GOAPTypes.h"
+#include "GOAPPlanner.h"
+#include "GOAPPlanCacheSubsystem.generated.h"
+
+/**
+ * @brief Key of a cached plan.
+ *
+ * A plan only depends on where the search starts, what it has to reach, the planning data
+ * of the actions and the search settings, so agents that share all of them can share the plan.
+ */
+struct GOAP_API FGOAPPlanCacheKey
+{
+    /** The packed start state. */
+    FGOAPPackedState Start;
+
+    /** The packed goal state. */
+    FGOAPPackedState Goal;
+
+    /** Signature of the action set, see FGOAPActionSet::Signature. */
+    uint64 ActionSetSignature = 0;
+
+    /** The search mode the plan was found with. */
+    EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward;
+
+    /** The heuristic the plan was found with, an overestimating one may return a different plan. */
+    EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount;
+
+    /** The heuristic weight the plan was found with, a weighted search may return a costlier plan. */
+    float HeuristicWeight = 1.f;
+
+    /** @return A canonical 64-bit hash of the whole key. */
+    uint64 GetHash() const
+    {
+        uint64 Hash = Start.GetHash();
+        Hash = Hash * 0x9E3779B97F4A7C15ull ^ Goal.GetHash();
+        Hash = Hash * 0x9E3779B97F4A7C15ull ^ ActionSetSignature;
+        Hash = Hash * 0x9E3779B97F4A7C15ull ^ (uint64)SearchMode;
+        Hash = Hash * 0x9E3779B97F4A7C15ull ^ (uint64)Heuristic;
+        Hash = Hash * 0x9E3779B97F4A7C15ull ^ (uint64)GetTypeHash(HeuristicWeight);
+        return Hash;
+    }
+
+    bool operator==(const FGOAPPlanCacheKey& Other) const
+    {
+        return ActionSetSignature == Other.ActionSetSignature
+            && SearchMode == Other.SearchMode
+            && Heuristic == Other.Heuristic
+            && HeuristicWeight == Other.HeuristicWeight
+            && Start == Other.Start
+            && Goal == Other.Goal;
+    }
+};
+
+/**
+ * @brief World-level cache of plans shared by all GOAP agents.
+ *
+ * Agents with identical actions keep landing in the same world state with the same goal.
+ * The first one plans, everyone after that gets the stored action sequence in O(1).
+ * Goals that were found unreachable are cached as negative entries so they are not
+ * searched again. The cache holds at most @ref MaxEntries plans and evicts the least
+ * recently used one when full.
+ */
+UCLASS(config = Game)
+class GOAP_API UGOAPPlanCacheSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UGOAPPlanCacheSubsystem();
+
+    /**
+     * @brief Looks up a cached plan.
+     *
+     * @param Key The cache key.
+     * @param OutActionIndices Receives the plan as indices into the agent's action list.
+     * @param bOutReachable Receives false if the entry records that the goal is unreachable.
+     * @return True on a cache hit.
+     */
+    bool Find(const FGOAPPlanCacheKey& Key, TArray<int32>& OutActionIndices, bool& bOutReachable);
+
+    /**
+     * @brief Stores the result of a search.
+     *
+     * @param Key The cache key.
+     * @param ActionIndices The plan found, ignored for unreachable goals.
+     * @param bReachable False to store a negative entry.
+     */
+    void Add(const FGOAPPlanCacheKey& Key, const TArray<int32>& ActionIndices, bool bReachable);
+
+    /**
+     * @brief Stores the outcome of a search, unless it failed for lack of budget.
+     *
+     * A plan is always stored. A failure is only stored as a negative entry when it proves the
+     * goal unreachable: the relaxed problem ruled it out, or every reachable node was expanded.
+     * Hitting the iteration limit or being cancelled says nothing about the goal, the next
+     * search with more budget may still find a plan.
+     *
+     * @param Key The cache key.
+     * @param ActionIndices The plan found, ignored if there is none.
+     * @param bFoundPlan Whether the search found a plan.
+     * @param Failure Why the search failed, if it did.
+     * @return True if the result was stored.
+     */
+    bool AddSearchResult(const FGOAPPlanCacheKey& Key, const TArray<int32>& ActionIndices, bool bFoundPlan, EGOAPSearchFailure Failure);
+
+    /** Removes every cached plan, keeps the counters. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Plan Cache")
+    void Clear();
+
+    /** @return Number of lookups that found a plan or a negative entry. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Plan Cache")
+    int64 GetHitCount() const { return Hits; }
+
+    /** @return Number of lookups that had to plan. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Plan Cache")
+    int64 GetMissCount() const { return Misses; }
+
+    /** @return Number of plans currently cached. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Plan Cache")
+    int32 GetNumEntries() const { return Lookup.Num(); }
+
+    /**
+     * @brief Maximum number of cached plans before the least recently used one is evicted.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|Plan Cache")
+    int32 MaxEntries = 1024;
+
+    virtual void Deinitialize() override;
+
+private:
+    /** One cached plan, linked into the LRU list. */
+    struct FEntry
+    {
+        FGOAPPlanCacheKey Key;
+        uint64 Hash = 0;
+        TArray<int32> ActionIndices;
+        bool bReachable = true;
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+    };
+
+    void Unlink(int32 EntryIndex);
+    void LinkAtHead(int32 EntryIndex);
+
+    /** Entry storage, slots are reused after eviction. */
+    TArray<FEntry> Entries;
+
+    /** Key hash to entry index. */
+    TMap<uint64, int32> Lookup;
+
+    /** Most recently used entry. */
+    int32 Head = INDEX_NONE;
+
+    /** Least recently used entry, evicted first. */
+    int32 Tail = INDEX_NONE;
+
+    int64 Hits = 0;
+    int64 Misses = 0;
+};
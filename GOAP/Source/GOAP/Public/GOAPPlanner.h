@@ -3,11 +3,284 @@
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
 #include "GOAPTypes.h"
+#include "GOAPActionSet.h"
 #include "GOAPDebug.h"
+#include "GOAPStats.h"
+#include "GOAPCore/PlanSearch.h"
+#include <atomic>
 #include "GOAPPlanner.generated.h"
 
 class UGOAPAction;
 
+/** One goal of a multi-goal search, a packed goal state and its priority. */
+using FGOAPGoalCandidate = GOAPCore::FGoalCandidate;
+
+/** Why a search failed: the goal is unreachable, or the search ran out of iterations or was cancelled. */
+using EGOAPSearchFailure = GOAPCore::ESearchFailure;
+
+/**
+ * @brief Snapshot and result of a plan computed on a worker thread.
+ *
+ * The inputs are copied when the request is made and the action data is shared immutably,
+ * so the worker never reads anything the game thread can change. The result fields are
+ * written by the worker and only read on the game thread once the completion callback runs.
+ */
+struct GOAP_API FGOAPAsyncPlanRequest
+{
+    /** Packed world state the search started from. */
+    FGOAPPackedState Current;
+
+    /** Packed goal state. */
+    FGOAPPackedState Goal;
+
+    /** The compiled actions the plan indexes into. */
+    TSharedPtr<const FGOAPActionSet, ESPMode::ThreadSafe> ActionSet;
+
+    EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None;
+    EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward;
+    EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount;
+
+    /** Heuristic weight of a single goal request, see UGOAPPlanner::HeuristicWeight. */
+    float HeuristicWeight = 1.f;
+
+    /** Candidate goals of a multi-goal request, empty to plan for @ref Goal only. */
+    TArray<FGOAPGoalCandidate> Goals;
+
+    /** Weight of the plan cost against goal priority in a multi-goal request. */
+    float CostWeight = 0.f;
+
+    /** Index into @ref Goals of the goal the plan reaches, @ref Goal is set to it as well. */
+    int32 GoalIndex = INDEX_NONE;
+
+    /** The plan found, as indices into the action list, in execution order. */
+    TArray<int32> ActionIndices;
+
+    /** Whether the search found a plan. */
+    bool bFoundPlan = false;
+
+    /** Why the search failed, None if it found a plan. */
+    EGOAPSearchFailure Failure = EGOAPSearchFailure::None;
+
+    /** Set to stop the search at its next iteration and drop the result. */
+    std::atomic<bool> bCancelled{ false };
+
+    /** Cancels the request, safe to call from any thread. */
+    void Cancel() { bCancelled.store(true, std::memory_order_relaxed); }
+
+    /** @return True if the request was cancelled. */
+    bool IsCancelled() const { return bCancelled.load(std::memory_order_relaxed); }
+};
+
+typedef TSharedRef<FGOAPAsyncPlanRequest, ESPMode::ThreadSafe> FGOAPAsyncPlanRequestRef;
+
+/** State of a resumable search: Idle, InProgress, Improving, Succeeded or Failed. */
+using EGOAPSearchStatus = GOAPCore::ESearchStatus;
+
+/**
+ * @brief A resumable A* search over compiled actions.
+ *
+ * Keeps its open list, node pool and closed set between calls, so a search can be spread
+ * over several frames by calling @ref Step with a small budget each time. Only touches its
+ * own data and the immutable action set, so it can also run on any thread.
+ *
+ * The search itself is GOAPCore::FPlanSearch. This keeps the action set it plans with alive,
+ * converts the engine enums and routes the core's log lines to the output log.
+ */
+struct GOAP_API FGOAPPlanSearch
+{
+    FGOAPPlanSearch();
+
+    /**
+     * @brief Starts a new search, discarding the previous one but keeping its allocations.
+     *
+     * @param InActionSet The compiled actions, kept alive until the next Start or Reset.
+     * @param InCurrent The current packed world state.
+     * @param InGoal The packed goal state to achieve.
+     * @param InDebugLevel Debug verbosity level for logging planner details.
+     * @param InSearchMode Search forward from the current state or regressively from the goal.
+     * @param InMaxIterations Expansions after which the search gives up.
+     * @param InHeuristic The estimate of the remaining cost that guides the search.
+     */
+    void Start(
+        const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet,
+        const FGOAPPackedState& InCurrent,
+        const FGOAPPackedState& InGoal,
+        EGOAPDebugLevel InDebugLevel,
+        EGOAPSearchMode InSearchMode,
+        int32 InMaxIterations,
+        EGOAPHeuristic InHeuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Starts a regressive search that reuses the graph of the previous one.
+     *
+     * Regressive nodes are subgoal sets derived from the goal alone, so their costs and
+     * parents stay valid when only the current state changed. Only the heuristic and the
+     * goal test depend on it: the heuristic of nodes mentioning a changed fact is updated,
+     * expanded nodes that the new state satisfies are reopened as goal candidates and the
+     * open list is rebuilt. A relaxed heuristic measures every node from the current state,
+     * so it is updated on every node. Falls back to a fresh search when the goal, the
+     * heuristic or the actions changed, the previous search was not regressive, or the
+     * graph grew too large.
+     *
+     * @param InActionSet The compiled actions.
+     * @param InCurrent The new current packed world state.
+     * @param InGoal The packed goal state to achieve.
+     * @param InDebugLevel Debug verbosity level for logging planner details.
+     * @param InMaxIterations Expansions after which this search gives up.
+     * @param InHeuristic The estimate of the remaining cost that guides the search.
+     * @return True if the previous graph was reused.
+     */
+    bool StartIncremental(
+        const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet,
+        const FGOAPPackedState& InCurrent,
+        const FGOAPPackedState& InGoal,
+        EGOAPDebugLevel InDebugLevel,
+        int32 InMaxIterations,
+        EGOAPHeuristic InHeuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Starts a forward search for the best of several goals in one pass.
+     *
+     * Forward nodes do not depend on the goal, so one open list and closed set serve every
+     * candidate. A goal reached with plan cost G is worth Priority - CostWeight * G. Nodes are
+     * expanded in order of the best utility any candidate could still reach through them,
+     * using the heuristic as a lower bound on the remaining cost, and the search ends once no
+     * open node can beat the best goal reached so far. With a zero weight this is the highest
+     * priority reachable goal, at any plan cost.
+     *
+     * @param InActionSet The compiled actions.
+     * @param InCurrent The current packed world state.
+     * @param InGoals The candidate goals.
+     * @param InCostWeight Utility lost per unit of plan cost.
+     * @param InDebugLevel Debug verbosity level for logging planner details.
+     * @param InMaxIterations Expansions after which the search settles for the best goal reached, if any.
+     * @param InHeuristic The estimate of the remaining cost, only an admissible one keeps the choice of goal exact.
+     */
+    void StartMultiGoal(
+        const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet,
+        const FGOAPPackedState& InCurrent,
+        TConstArrayView<FGOAPGoalCandidate> InGoals,
+        float InCostWeight,
+        EGOAPDebugLevel InDebugLevel,
+        int32 InMaxIterations,
+        EGOAPHeuristic InHeuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Starts an anytime search that finds a first plan fast and then refines it (ARA*).
+     *
+     * Runs weighted A* with the heuristic inflated by InInitialWeight. Once the best goal
+     * node found cannot be beaten at the current weight, the plan is published and @ref Step
+     * returns Improving. The next steps lower the weight by InWeightStep and continue from
+     * the same graph: nodes whose cost improved after they were expanded are reopened
+     * instead of searched again. The search succeeds once the weight reaches one or the
+     * plan is proven optimal.
+     *
+     * @param InActionSet The compiled actions.
+     * @param InCurrent The current packed world state.
+     * @param InGoal The packed goal state to achieve.
+     * @param InInitialWeight Heuristic inflation of the first search, at least one.
+     * @param InWeightStep How much the weight drops after each published plan.
+     * @param InDebugLevel Debug verbosity level for logging planner details.
+     * @param InSearchMode Search forward from the current state or regressively from the goal.
+     * @param InMaxIterations Expansions after which the search settles for its last plan, if any.
+     * @param InHeuristic The estimate of the remaining cost. The suboptimality bound only holds for an admissible one.
+     */
+    void StartAnytime(
+        const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet,
+        const FGOAPPackedState& InCurrent,
+        const FGOAPPackedState& InGoal,
+        float InInitialWeight,
+        float InWeightStep,
+        EGOAPDebugLevel InDebugLevel,
+        EGOAPSearchMode InSearchMode,
+        int32 InMaxIterations,
+        EGOAPHeuristic InHeuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Continues the search within a budget.
+     *
+     * At least one node is expanded per call, so a search always makes progress. An anytime
+     * search returns after each plan it publishes.
+     *
+     * @param MaxExpansions Number of nodes to expand at most.
+     * @param MaxMicroseconds Time budget for this call, zero or less for no time limit.
+     * @param bCancelled Optional flag polled every expansion, the search fails once it is set.
+     * @return The status after this step.
+     */
+    EGOAPSearchStatus Step(int32 MaxExpansions, double MaxMicroseconds = 0.0, const std::atomic<bool>* bCancelled = nullptr);
+
+    /** Drops the search and the action set it holds, keeping the allocations. */
+    void Reset();
+
+    EGOAPSearchStatus GetStatus() const { return Core.GetStatus(); }
+    bool IsInProgress() const { return Core.IsInProgress(); }
+
+    /** @return The plan as indices into the action list, in execution order, once the search succeeded. */
+    const TArray<int32>& GetPlan() const { return Plan; }
+
+    /** @return Number of nodes expanded so far. */
+    int32 GetNumIterations() const { return Core.GetNumIterations(); }
+
+    /** @return Number of nodes generated so far, expanded or not. */
+    int32 GetNumNodes() const { return Core.GetNumNodes(); }
+
+    /** @return Work done by the current search and why it failed, if it did. */
+    const GOAPCore::FSearchStats& GetStats() const { return Core.GetStats(); }
+
+    const TSharedPtr<const FGOAPActionSet, ESPMode::ThreadSafe>& GetActionSet() const { return ActionSet; }
+    const FGOAPPackedState& GetCurrent() const { return Core.GetCurrent(); }
+    const FGOAPPackedState& GetGoal() const { return Core.GetGoal(); }
+    EGOAPSearchMode GetSearchMode() const;
+    EGOAPHeuristic GetHeuristic() const { return (EGOAPHeuristic)Core.GetHeuristic(); }
+
+    /** @return True if the search was started by @ref StartMultiGoal. */
+    bool IsMultiGoal() const { return Core.IsMultiGoal(); }
+
+    /** @return Index of the candidate a multi-goal search reached, INDEX_NONE before one is reached. */
+    int32 GetGoalIndex() const { return Core.GetGoalIndex(); }
+
+    /** @return True if the search was started by @ref StartAnytime. */
+    bool IsAnytime() const { return Core.IsAnytime(); }
+
+    /** @return Number of plans an anytime search has published, each one at least as cheap as the last. */
+    int32 GetNumSolutions() const { return Core.GetNumSolutions(); }
+
+    /**
+     * @return Factor by which the last published plan may exceed the optimal cost, one once
+     *         it is proven optimal. Only meaningful for anytime searches with an admissible heuristic.
+     */
+    float GetSuboptimalityBound() const { return Core.GetSuboptimalityBound(); }
+
+    /** @return The engine independent search doing the work. */
+    const GOAPCore::FPlanSearch& GetCore() const { return Core; }
+
+private:
+    /**
+     * Copies the core's plan into @ref Plan, called after every call that can change it.
+     * Also reports a search that just finished to `stat GOAP` and the CSV profiler, once.
+     */
+    void SyncPlan();
+
+    /** The search, it references the action set held by @ref ActionSet. */
+    GOAPCore::FPlanSearch Core;
+
+    /** Keeps the action set the core plans with alive until the next Start or Reset. */
+    TSharedPtr<const FGOAPActionSet, ESPMode::ThreadSafe> ActionSet;
+
+    /** The core's plan as an engine array. */
+    TArray<int32> Plan;
+
+    /** True once the current search was reported, cleared by every Start. */
+    bool bStatsRecorded = false;
+};
+
+/** Called on the game thread when an async plan request finishes without being cancelled. */
+DECLARE_DELEGATE_OneParam(FGOAPOnAsyncPlanComplete, const FGOAPAsyncPlanRequestRef&);
+
 /**
  * @brief GOAP planner that computes an action sequence to achieve a desired goal.
  *
@@ -32,6 +305,8 @@ public:
      * @param Actions The list of available actions that can be used to plan.
      * @param OutPlan Output array that will contain the resulting ordered plan.
      * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param SearchMode Search forward from the current state or regressively from the goal.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
      * @return True if a valid plan was found, false otherwise.
      */
     UFUNCTION(BlueprintCallable, Category = "GOAP")
@@ -40,6 +315,314 @@ public:
         const FGOAPWorldState& Goal,
         const TArray<UGOAPAction*>& Actions,
         TArray<UGOAPAction*>& OutPlan,
-        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Writes the planner trace of every thread to a file, decode it with GOAPTraceDecode.
+     *
+     * Only searches run at EGOAPDebugLevel::Detailed record events, each thread keeps its
+     * most recent ones in a fixed ring buffer. Also available as the GOAP.DumpPlannerTrace
+     * console command.
+     *
+     * @param FilePath Destination file, empty for Saved/GOAP/PlannerTrace_<time>.goaptrace.
+     * @return The path written, empty if the file could not be written.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Debug")
+    static FString DumpPlannerTrace(const FString& FilePath);
+
+    /**
+     * @brief Native planning entry point working directly on packed states.
+     *
+     * Same as @ref Plan but skips the TMap conversion, used by agents that already
+     * keep a packed world state.
+     *
+     * @param Current The current packed world state.
+     * @param Goal The packed goal state to achieve.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param OutPlan Output array that will contain the resulting ordered plan.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param SearchMode Search forward from the current state or regressively from the goal.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     * @return True if a valid plan was found, false otherwise.
+     */
+    bool PlanPacked(
+        const FGOAPPackedState& Current,
+        const FGOAPPackedState& Goal,
+        const TArray<UGOAPAction*>& Actions,
+        TArray<UGOAPAction*>& OutPlan,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Native planning entry point returning action indices instead of pointers.
+     *
+     * @param Current The current packed world state.
+     * @param Goal The packed goal state to achieve.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param OutActionIndices Output array of indices into Actions, in execution order.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param SearchMode Search forward from the current state or regressively from the goal.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     * @param OutFailure Optionally receives why the search failed, None if it found a plan.
+     * @return True if a valid plan was found, false otherwise.
+     */
+    bool PlanIndices(
+        const FGOAPPackedState& Current,
+        const FGOAPPackedState& Goal,
+        const TArray<UGOAPAction*>& Actions,
+        TArray<int32>& OutActionIndices,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount,
+        EGOAPSearchFailure* OutFailure = nullptr
+    );
+
+    /**
+     * @brief Plans for the best of several goals in one forward search, see FGOAPPlanSearch::StartMultiGoal.
+     *
+     * @param Current The current packed world state.
+     * @param Goals The candidate goals with their priorities.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param OutActionIndices Output array of indices into Actions, in execution order.
+     * @param OutGoalIndex Receives the index into Goals of the goal the plan reaches.
+     * @param CostWeight Utility lost per unit of plan cost.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     * @return True if any goal can be reached.
+     */
+    bool PlanMultiGoal(
+        const FGOAPPackedState& Current,
+        TConstArrayView<FGOAPGoalCandidate> Goals,
+        const TArray<UGOAPAction*>& Actions,
+        TArray<int32>& OutActionIndices,
+        int32& OutGoalIndex,
+        float CostWeight = 0.f,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
     );
+
+    /**
+     * @brief Plans within a time budget, returning the best plan found so far.
+     *
+     * Runs an anytime search (see FGOAPPlanSearch::StartAnytime) until it is proven optimal
+     * or the budget is spent. Read the quality of the result from
+     * GetSearch().GetSuboptimalityBound(). Use @ref BeginPlanAnytime to keep refining over frames.
+     *
+     * @param Current The current packed world state.
+     * @param Goal The packed goal state to achieve.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param OutActionIndices Output array of indices into Actions, in execution order.
+     * @param MaxMicroseconds Time budget for the whole call.
+     * @param InitialWeight Heuristic inflation of the first pass.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param SearchMode Search forward from the current state or regressively from the goal.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     * @return True if a plan was found within the budget.
+     */
+    bool PlanAnytime(
+        const FGOAPPackedState& Current,
+        const FGOAPPackedState& Goal,
+        const TArray<UGOAPAction*>& Actions,
+        TArray<int32>& OutActionIndices,
+        double MaxMicroseconds,
+        float InitialWeight = 3.f,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Returns the compiled planning data for an action list, rebuilding it if needed.
+     *
+     * @param Actions The list of actions to plan with.
+     * @return The compiled action set, valid until the next call with a different list.
+     */
+    const FGOAPActionSet& GetActionSet(const TArray<UGOAPAction*>& Actions);
+
+    /**
+     * @brief Same as @ref GetActionSet but shares ownership, for users that outlive the next rebuild.
+     *
+     * @param Actions The list of actions to plan with.
+     * @return The compiled action set, never modified after it is returned.
+     */
+    TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe> GetSharedActionSet(const TArray<UGOAPAction*>& Actions);
+
+    /**
+     * @brief Plans with an action set compiled elsewhere instead of building a copy.
+     *
+     * Lets the planners of many agents share one set, see UGOAPDomain. It stays in use as
+     * long as the action lists passed to the planner still match it.
+     *
+     * @param InActionSet The compiled action set.
+     */
+    void SetActionSet(const TSharedRef<const FGOAPActionSet, ESPMode::ThreadSafe>& InActionSet) { ActionSet = InActionSet; }
+
+    /**
+     * @brief Starts a search on a thread pool worker.
+     *
+     * Must be called on the game thread. The states and compiled actions are snapshotted,
+     * so the caller is free to change them while the search runs.
+     *
+     * @param Current The current packed world state.
+     * @param Goal The packed goal state to achieve.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param OnComplete Called on the game thread with the finished request, unless it was cancelled.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param SearchMode Search forward from the current state or regressively from the goal.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     * @return The request, keep it to read the result or to cancel it.
+     */
+    FGOAPAsyncPlanRequestRef PlanAsync(
+        const FGOAPPackedState& Current,
+        const FGOAPPackedState& Goal,
+        const TArray<UGOAPAction*>& Actions,
+        FGOAPOnAsyncPlanComplete OnComplete,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Multi-goal version of @ref PlanAsync, the request's GoalIndex tells which goal was reached.
+     *
+     * @param Current The current packed world state.
+     * @param Goals The candidate goals with their priorities.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param OnComplete Called on the game thread with the finished request, unless it was cancelled.
+     * @param CostWeight Utility lost per unit of plan cost.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     * @return The request, keep it to read the result or to cancel it.
+     */
+    FGOAPAsyncPlanRequestRef PlanMultiGoalAsync(
+        const FGOAPPackedState& Current,
+        TConstArrayView<FGOAPGoalCandidate> Goals,
+        const TArray<UGOAPAction*>& Actions,
+        FGOAPOnAsyncPlanComplete OnComplete,
+        float CostWeight = 0.f,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Starts a resumable search, replacing any search in progress.
+     *
+     * Advance it with @ref StepPlan, typically once per frame. @ref Plan and @ref PlanIndices
+     * use the same search and cancel one started here. With a @ref HeuristicWeight above one
+     * the search is an anytime search that never lowers its weight, see FGOAPPlanSearch::IsAnytime.
+     *
+     * @param Current The current packed world state.
+     * @param Goal The packed goal state to achieve.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param SearchMode Search forward from the current state or regressively from the goal.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     */
+    void BeginPlan(
+        const FGOAPPackedState& Current,
+        const FGOAPPackedState& Goal,
+        const TArray<UGOAPAction*>& Actions,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Starts a resumable multi-goal search, replacing any search in progress.
+     *
+     * @param Current The current packed world state.
+     * @param Goals The candidate goals with their priorities.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param CostWeight Utility lost per unit of plan cost.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     */
+    void BeginPlanMultiGoal(
+        const FGOAPPackedState& Current,
+        TConstArrayView<FGOAPGoalCandidate> Goals,
+        const TArray<UGOAPAction*>& Actions,
+        float CostWeight = 0.f,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Starts a resumable anytime search, replacing any search in progress.
+     *
+     * @ref StepPlan returns Improving each time a better plan is available and Succeeded once
+     * the plan is proven optimal.
+     *
+     * @param Current The current packed world state.
+     * @param Goal The packed goal state to achieve.
+     * @param Actions The list of available actions that can be used to plan.
+     * @param InitialWeight Heuristic inflation of the first pass.
+     * @param DebugLevel Optional debug verbosity level for logging planner details.
+     * @param SearchMode Search forward from the current state or regressively from the goal.
+     * @param Heuristic The estimate of the remaining cost that guides the search.
+     */
+    void BeginPlanAnytime(
+        const FGOAPPackedState& Current,
+        const FGOAPPackedState& Goal,
+        const TArray<UGOAPAction*>& Actions,
+        float InitialWeight = 3.f,
+        EGOAPDebugLevel DebugLevel = EGOAPDebugLevel::None,
+        EGOAPSearchMode SearchMode = EGOAPSearchMode::Forward,
+        EGOAPHeuristic Heuristic = EGOAPHeuristic::GoalCount
+    );
+
+    /**
+     * @brief Advances the search started by @ref BeginPlan, @ref BeginPlanMultiGoal or @ref BeginPlanAnytime.
+     *
+     * @param MaxExpansions Number of nodes to expand at most.
+     * @param MaxMicroseconds Time budget for this call, zero or less for no time limit.
+     * @return The search status, read the plan from @ref GetSearch once it succeeded.
+     */
+    EGOAPSearchStatus StepPlan(int32 MaxExpansions, double MaxMicroseconds = 0.0);
+
+    /** Stops the search started by @ref BeginPlan. */
+    void CancelPlan() { Search.Reset(); }
+
+    /** @return The planner's search, holding the result of the last plan. */
+    const FGOAPPlanSearch& GetSearch() const { return Search; }
+
+    /**
+     * @brief Maximum number of node expansions before a search gives up.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    int32 MaxIterations = 5000;
+
+    /**
+     * @brief How much an anytime search lowers its heuristic weight after each plan.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (ClampMin = "0.01"))
+    float AnytimeWeightStep = 0.5f;
+
+    /**
+     * @brief Inflation of the heuristic in single goal searches, one keeps plans optimal.
+     *
+     * Above one the search runs weighted A*: it expands fewer nodes and returns a plan at most
+     * this factor more expensive than the cheapest one, given an admissible heuristic.
+     * Incremental searches on the game thread and multi-goal searches ignore it.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (ClampMin = "1"))
+    float HeuristicWeight = 1.f;
+
+private:
+    /** Runs a filled in request on a thread pool worker. */
+    FGOAPAsyncPlanRequestRef LaunchAsync(const FGOAPAsyncPlanRequestRef& Request, FGOAPOnAsyncPlanComplete OnComplete);
+
+    /** The search used by the synchronous and time-sliced entry points. */
+    FGOAPPlanSearch Search;
+
+    /**
+     * @brief Compiled planning data and inverted indices of the last action list planned with.
+     *
+     * Replaced rather than rebuilt in place when the actions change, async requests hold on to the old one.
+     */
+    TSharedPtr<const FGOAPActionSet, ESPMode::ThreadSafe> ActionSet;
 };
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GOAPTypes.h"
+#include "GOAPReplanSubsystem.generated.h"
+
+class AGOAPAgent;
+
+/**
+ * @brief World-level queue that spreads agent replans over frames.
+ *
+ * Agents enqueue themselves instead of planning right away. Every frame the scheduler
+ * plans queued agents until its time budget is spent, most urgent class first, so a
+ * world event that makes hundreds of agents replan at once no longer spikes one frame.
+ * A request that has waited longer than its class allows is planned even when the
+ * budget is already spent, which bounds the latency of every class.
+ */
+UCLASS(config = Game)
+class GOAP_API UGOAPReplanSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * @brief Queues a replan for an agent.
+     *
+     * An agent is queued at most once. Requesting again with a higher urgency moves it
+     * to the more urgent queue, a lower urgency keeps its current place.
+     *
+     * @param Agent The agent to replan.
+     * @param Urgency The urgency class to queue it in.
+     */
+    void RequestReplan(AGOAPAgent* Agent, EGOAPUrgency Urgency);
+
+    /**
+     * @brief Removes an agent from the queue, for example when it is destroyed.
+     *
+     * @param Agent The agent to remove.
+     */
+    void CancelReplan(AGOAPAgent* Agent);
+
+    /** @return True if the agent is waiting for a replan. */
+    bool IsQueued(const AGOAPAgent* Agent) const;
+
+    /** @return Number of agents waiting in one urgency class. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Replan")
+    int32 GetQueueDepth(EGOAPUrgency Urgency) const;
+
+    /** @return Number of agents waiting in all classes. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Replan")
+    int32 GetTotalQueueDepth() const { return Queued.Num(); }
+
+    /** @return Largest total queue depth seen since the world started. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Replan")
+    int32 GetPeakQueueDepth() const { return PeakQueueDepth; }
+
+    /** @return Number of replans run during the last tick. */
+    UFUNCTION(BlueprintCallable, Category = "GOAP|Replan")
+    int32 GetReplansLastFrame() const { return ReplansLastFrame; }
+
+    /**
+     * @brief Planning time the scheduler may spend per frame, in milliseconds.
+     *
+     * At least one replan runs per frame when agents are waiting, and overdue requests
+     * run regardless of the budget.
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|Replan")
+    float FrameBudgetMs = 1.0f;
+
+    /** @brief Longest a Low urgency request may wait, in seconds. */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|Replan")
+    float MaxLatencyLow = 1.0f;
+
+    /** @brief Longest a Normal urgency request may wait, in seconds. */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|Replan")
+    float MaxLatencyNormal = 0.25f;
+
+    /** @brief Longest a High urgency request may wait, in seconds. */
+    UPROPERTY(Config, EditAnywhere, Category = "GOAP|Replan")
+    float MaxLatencyHigh = 0.05f;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual void Deinitialize() override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** One queued request. */
+    struct FQueuedReplan
+    {
+        TWeakObjectPtr<AGOAPAgent> Agent;
+        double RequestTime = 0.0;
+
+        /** Matches the agent's entry in @ref Queued while this request is live. */
+        uint32 Sequence = 0;
+    };
+
+    /** Where a queued agent's live request sits. */
+    struct FQueuedAgent
+    {
+        EGOAPUrgency Urgency = EGOAPUrgency::Low;
+        uint32 Sequence = 0;
+    };
+
+    /** FIFO of one urgency class, consumed from @ref Head and compacted once drained. */
+    struct FReplanQueue
+    {
+        TArray<FQueuedReplan> Entries;
+        int32 Head = 0;
+        int32 NumQueued = 0;
+
+        bool IsEmpty() const { return Head >= Entries.Num(); }
+    };
+
+    /**
+     * @brief Pops the next live entry of a class and replans its agent.
+     *
+     * Entries of agents that were destroyed, cancelled, moved to another class or queued
+     * again since are skipped.
+     *
+     * @param Urgency The class to serve.
+     * @param bOnlyOverdue Only serve the entry if it has waited longer than its class allows.
+     * @param Now Current real time in seconds.
+     * @return True if an agent was replanned.
+     */
+    bool ServeNext(EGOAPUrgency Urgency, bool bOnlyOverdue, double Now);
+
+    float GetMaxLatency(EGOAPUrgency Urgency) const;
+
+    double GetNow() const;
+
+    FReplanQueue Queues[(int32)EGOAPUrgency::Num];
+
+    /** The live request of each queued agent, entries with another sequence number are stale. */
+    TMap<TWeakObjectPtr<AGOAPAgent>, FQueuedAgent> Queued;
+
+    uint32 NextSequence = 0;
+
+    int32 PeakQueueDepth = 0;
+    int32 ReplansLastFrame = 0;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/// \file GOAPStats.h
+
+/**
+ * @brief Planner profiling: Unreal Insights scopes, `stat GOAP` and the GOAP CSV category.
+ *
+ * The planning core has no engine dependency, it marks its hot paths with
+ * GOAPCORE_TRACE_SCOPE. GOAP.Build.cs defines it for the module, which turns those marks
+ * into Insights CPU scopes on whichever thread searches.
+ */
+
+namespace GOAPCore
+{
+    struct FSearchStats;
+}
+
+DECLARE_STATS_GROUP(TEXT("GOAP"), STATGROUP_GOAP, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GOAP Planner Tick"), STAT_GOAPPlannerTick, STATGROUP_GOAP, GOAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GOAP Execute Goal"), STAT_GOAPExecureGoal, STATGROUP_GOAP, GOAP_API);
+
+/** Counted per frame over every finished search. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Searches"), STAT_GOAPSearches, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Expanded"), STAT_GOAPNodesExpanded, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Generated"), STAT_GOAPNodesGenerated, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Plan Steps"), STAT_GOAPPlanSteps, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Failed: Unreachable"), STAT_GOAPFailedUnreachable, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Failed: Exhausted"), STAT_GOAPFailedExhausted, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Failed: Iteration Limit"), STAT_GOAPFailedIterationLimit, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Failed: Cancelled"), STAT_GOAPFailedCancelled, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Plan Cache Hits"), STAT_GOAPPlanCacheHits, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Plan Cache Misses"), STAT_GOAPPlanCacheMisses, STATGROUP_GOAP, GOAP_API);
+
+/** Values of the last finished search, the Max column shows the worst one. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Peak Open (last search)"), STAT_GOAPPeakOpen, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Peak Closed (last search)"), STAT_GOAPPeakClosed, STATGROUP_GOAP, GOAP_API);
+
+/** Hits over lookups since the world's plan cache was created. */
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Plan Cache Hit Rate"), STAT_GOAPPlanCacheHitRate, STATGROUP_GOAP, GOAP_API);
+
+/** Agents per level of detail at the last LOD update. */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Agents: LOD High"), STAT_GOAPAgentsLODHigh, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Agents: LOD Medium"), STAT_GOAPAgentsLODMedium, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Agents: LOD Low"), STAT_GOAPAgentsLODLow, STATGROUP_GOAP, GOAP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Agents: LOD Dormant"), STAT_GOAPAgentsLODDormant, STATGROUP_GOAP, GOAP_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(GOAP_API, GOAP);
+
+/**
+ * @brief Reports one finished search to `stat GOAP` and the CSV profiler.
+ *
+ * Safe to call from worker threads, async searches report where they ran.
+ *
+ * @param Stats The work done by the search.
+ * @param PlanLength Number of steps of the plan found, zero if the search failed.
+ */
+GOAP_API void GOAPRecordSearchStats(const GOAPCore::FSearchStats& Stats, int32 PlanLength);
@@ -1,9 +1,167 @@
 #pragma once
 #include "CoreMinimal.h"
+#include "GOAPFactRegistry.h"
 #include "GOAPTypes.generated.h"
 
 /// \file GOAPTypes.h
 
+/**
+ * @brief Direction in which the planner searches for a plan.
+ */
+UENUM(BlueprintType)
+enum class EGOAPSearchMode : uint8
+{
+    /** Use the owner's setting. Goals defer to their agent, agents fall back to Forward. */
+    Default UMETA(DisplayName = "Default"),
+
+    /** Search from the current state, expanding every applicable action. */
+    Forward UMETA(DisplayName = "Forward"),
+
+    /** Search back from the goal, only expanding actions whose effects achieve an open subgoal. */
+    Regressive UMETA(DisplayName = "Regressive"),
+
+    /**
+     * Regressive search that keeps its search graph between replans for the same goal.
+     * The graph does not depend on the current state, so a replan only updates priorities.
+     */
+    Incremental UMETA(DisplayName = "Incremental")
+};
+
+/**
+ * @brief Estimate of the remaining plan cost used to guide the search.
+ *
+ * The relaxed heuristics ignore that effects can undo facts and work on action costs,
+ * see GOAPCore::FRelaxedHeuristic.
+ */
+UENUM(BlueprintType)
+enum class EGOAPHeuristic : uint8
+{
+    /** Number of unsatisfied goal facts. Cheap, but blind to action costs. */
+    GoalCount UMETA(DisplayName = "Goal Count"),
+
+    /** Cost of the most expensive goal fact in the relaxed problem. Admissible, plans stay optimal. */
+    Max UMETA(DisplayName = "Relaxed Max"),
+
+    /** Sum of the relaxed costs of the goal facts. Well informed but may overestimate. */
+    Add UMETA(DisplayName = "Relaxed Add"),
+
+    /** Cost of a relaxed plan without repeated actions. Usually the best guidance, may overestimate. */
+    FF UMETA(DisplayName = "Relaxed Plan (FF)")
+};
+
+/**
+ * @brief How quickly a replan has to happen, used by the replan scheduler.
+ *
+ * Each class has its own queue and maximum latency, more urgent classes are served first.
+ */
+UENUM(BlueprintType)
+enum class EGOAPUrgency : uint8
+{
+    /** Background behaviour like patrolling, can wait a while. */
+    Low UMETA(DisplayName = "Low"),
+
+    /** Regular goals. */
+    Normal UMETA(DisplayName = "Normal"),
+
+    /** Combat and other goals that must react within a few frames. */
+    High UMETA(DisplayName = "High"),
+
+    Num UMETA(Hidden)
+};
+
+/**
+ * @brief Level of detail an agent thinks at, picked by UGOAPLODSubsystem.
+ *
+ * Agents far from every view tick less often, react later and plan with a smaller budget.
+ */
+UENUM(BlueprintType)
+enum class EGOAPLOD : uint8
+{
+    /** Close to a view, full detail. */
+    High UMETA(DisplayName = "High"),
+
+    Medium UMETA(DisplayName = "Medium"),
+
+    Low UMETA(DisplayName = "Low"),
+
+    /** Out of range of every view. The agent keeps running its action but does not plan. */
+    Dormant UMETA(DisplayName = "Dormant"),
+
+    Num UMETA(Hidden)
+};
+
+/**
+ * @brief What an agent's ticking and planning are scaled by at one level of detail.
+ *
+ * The defaults are full detail.
+ */
+USTRUCT(BlueprintType)
+struct GOAP_API FGOAPLODSettings
+{
+    GENERATED_BODY()
+
+    /** Agents closer than this to the nearest view use this level, in cm. Unused by Dormant. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP|LOD", meta = (ClampMin = "0"))
+    float MaxDistance = 0.f;
+
+    /** Actor tick interval in seconds, zero ticks every frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP|LOD", meta = (ClampMin = "0"))
+    float TickInterval = 0.f;
+
+    /** Multiplies the agent's reaction time before it replans. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP|LOD", meta = (ClampMin = "0"))
+    float ReactionTimeScale = 1.f;
+
+    /** Multiplies the agent's planner iteration limit and time-sliced budget. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP|LOD", meta = (ClampMin = "0.01"))
+    float PlanBudgetScale = 1.f;
+
+    /** Heuristic weight of the agent's searches, see UGOAPPlanner::HeuristicWeight. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP|LOD", meta = (ClampMin = "1"))
+    float HeuristicWeight = 1.f;
+
+    /** Least time between two patrol destinations in seconds, zero picks the next one on arrival. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP|LOD", meta = (ClampMin = "0"))
+    float PatrolRetargetInterval = 0.f;
+};
+
+/**
+ * @brief Bit-packed world state used by the planner.
+ *
+ * Defined by the engine independent planning core, see GOAPCore::FPackedState. Fact indices
+ * come from FGOAPFactRegistry, use @ref GOAPPackFacts and @ref GOAPUnpackFacts to convert
+ * from and to named facts.
+ */
+using FGOAPPackedState = GOAPCore::FPackedState;
+
+/**
+ * @brief Builds a packed state from name/value pairs, registering unknown facts.
+ *
+ * @param Facts The facts to pack.
+ * @return The packed state.
+ */
+GOAP_API FGOAPPackedState GOAPPackFacts(const TMap<FName, bool>& Facts);
+
+/**
+ * @brief Builds a packed state from name/value pairs and reports facts that could not be packed.
+ *
+ * Facts are dropped once the registry is full, so a condition set packed this way is weaker
+ * than the one it came from. Callers that plan with it must not use an incomplete result.
+ *
+ * @param Facts The facts to pack.
+ * @param OutState Receives the packed state.
+ * @return False if at least one fact could not be registered.
+ */
+GOAP_API bool GOAPPackFacts(const TMap<FName, bool>& Facts, FGOAPPackedState& OutState);
+
+/**
+ * @brief Expands a packed state back into name/value pairs.
+ *
+ * @param State The packed state.
+ * @param OutFacts Receives every known fact of the state.
+ */
+GOAP_API void GOAPUnpackFacts(const FGOAPPackedState& State, TMap<FName, bool>& OutFacts);
+
 /**
  * @brief Represents a set of world state facts for the GOAP system.
  *
@@ -11,7 +169,7 @@
  * It supports operations to compare and merge world states.
  */
 USTRUCT(BlueprintType)
-struct FGOAPWorldState
+struct GOAP_API FGOAPWorldState
 {
     GENERATED_BODY()
 
@@ -61,4 +219,74 @@ struct FGOAPWorldState
             Bools.FindOrAdd(Pair.Key) = Pair.Value;
         }
     }
+
+    /**
+     * @brief Converts this state into the bit-packed form used by the planner.
+     *
+     * @return The packed representation of @ref Bools.
+     */
+    FGOAPPackedState ToPacked() const
+    {
+        return GOAPPackFacts(Bools);
+    }
+};
+
+/**
+ * @brief A boolean fact derived from a numeric channel.
+ *
+ * The fact turns true when the channel value crosses @ref Threshold and only turns false
+ * again once the value is @ref Hysteresis back on the other side, so a value hovering
+ * around the threshold does not flip the fact every frame.
+ */
+USTRUCT(BlueprintType)
+struct GOAP_API FGOAPChannelThreshold
+{
+    GENERATED_BODY()
+
+    /** The derived fact, e.g. "IsExhausted". */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    FName Fact;
+
+    /** The value at which the fact turns true. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    float Threshold = 0.f;
+
+    /** True if the fact holds at or below the threshold, false if it holds at or above it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bTrueBelow = true;
+
+    /** How far the value must move back past the threshold before the fact turns false. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP", meta = (ClampMin = "0"))
+    float Hysteresis = 0.f;
+};
+
+/**
+ * @brief A continuous quantity of the world state, like stamina or ammo.
+ *
+ * The planner never sees the value itself, only the facts derived from its thresholds.
+ */
+USTRUCT(BlueprintType)
+struct GOAP_API FGOAPNumericChannel
+{
+    GENERATED_BODY()
+
+    /** Name the channel is looked up by. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    FName Name;
+
+    /** Value the channel starts with. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    float InitialValue = 0.f;
+
+    /** Lowest value the channel can hold. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    float MinValue = 0.f;
+
+    /** Highest value the channel can hold. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    float MaxValue = 100.f;
+
+    /** The facts derived from this channel. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    TArray<FGOAPChannelThreshold> Thresholds;
 };
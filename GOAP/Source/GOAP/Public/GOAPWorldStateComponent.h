@@ -14,6 +14,16 @@ class AGOAPAgent;
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnWorldStateChanged);
 
+class UGOAPWorldStateComponent;
+
+/**
+ * @brief Native delegate called whenever the world state changes, with the facts that changed.
+ *
+ * The changed facts are passed as a packed state whose mask holds the facts that were
+ * added or flipped and whose values hold their new values.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWorldStateFactsChanged, UGOAPWorldStateComponent* /*Component*/, const FGOAPPackedState& /*ChangedFacts*/);
+
 /**
  * @brief Component that tracks the agents knowledge of the world in the system.
  *
@@ -64,12 +74,137 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "GOAP")
     FOnWorldStateChanged OnWorldStateChanged;
 
+    /**
+     * @brief Native event triggered whenever the world state changes, carrying the changed facts.
+     *
+     * Broadcast before @ref OnWorldStateChanged. Cheaper than the dynamic event and lets
+     * listeners ignore changes to facts they do not care about.
+     */
+    FOnWorldStateFactsChanged OnFactsChanged;
+
     /**
      * @brief Applies a set of effects to the current world state.
      *
-     * If any state actually changes, triggers the OnWorldStateChanged delegate.
+     * If any state actually changes, triggers @ref OnFactsChanged with the changed facts
+     * and then the OnWorldStateChanged delegate.
      *
      * @param Effects The key-value pairs representing state changes to apply.
      */
     void Apply(const TMap<FName, bool>& Effects);
+
+    /**
+     * @brief Returns the bit-packed mirror of @ref CurrentState used for planning.
+     */
+    const FGOAPPackedState& GetPackedState() const { return PackedState; }
+
+    /**
+     * @brief Rebuilds the packed mirror from @ref CurrentState.
+     *
+     * Only needed if @ref CurrentState was written directly instead of through @ref Apply.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    void RebuildPackedState();
+
+    /**
+     * @brief Numeric quantities tracked next to the boolean facts.
+     *
+     * Each threshold of a channel drives a boolean fact. Changing a channel value only
+     * touches @ref CurrentState and broadcasts a change when a threshold is crossed.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    TArray<FGOAPNumericChannel> NumericChannels;
+
+    /**
+     * @brief Finds a numeric channel by name.
+     *
+     * Look the index up once and keep it, the value accessors take the index.
+     *
+     * @param Name The channel name.
+     * @return The channel index, or INDEX_NONE if there is no such channel.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    int32 FindChannel(FName Name) const;
+
+    /**
+     * @brief Returns the current value of a numeric channel.
+     *
+     * @param Channel The index returned by @ref FindChannel.
+     * @return The value, or 0 for an invalid index.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    float GetChannelValue(int32 Channel) const;
+
+    /**
+     * @brief Sets a numeric channel, updating its derived facts if a threshold is crossed.
+     *
+     * @param Channel The index returned by @ref FindChannel.
+     * @param Value The new value, clamped to the channel's range.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    void SetChannelValue(int32 Channel, float Value);
+
+    /**
+     * @brief Adds to a numeric channel, updating its derived facts if a threshold is crossed.
+     *
+     * @param Channel The index returned by @ref FindChannel.
+     * @param Delta The amount to add, negative to drain the channel.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    void AddChannelValue(int32 Channel, float Delta);
+
+    /**
+     * @brief Rebuilds the channel runtime data from @ref NumericChannels and resets every value.
+     *
+     * Only needed if @ref NumericChannels was changed after initialization.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    void RebuildChannels();
+
+    /**
+     * @brief Restores the facts and channel values the component was initialized with.
+     *
+     * Used when a pooled agent is reused.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    void ResetState();
+
+    virtual void InitializeComponent() override;
+
+protected:
+    /** Packed copy of @ref CurrentState, kept in sync by @ref Apply. */
+    FGOAPPackedState PackedState;
+
+    /** @ref CurrentState as it was at initialization, restored by @ref ResetState. */
+    FGOAPWorldState InitialState;
+
+private:
+    /** Writes one fact to both state mirrors and records it in ChangedFacts if it changed. */
+    void SetFact(FName Name, int32 FactIndex, bool bValue, FGOAPPackedState& ChangedFacts);
+
+    /** Notifies listeners of the facts written since the last broadcast, if any. */
+    void BroadcastChanges(const FGOAPPackedState& ChangedFacts);
+
+    /** Runtime data of a channel, its thresholds are a range of @ref ThresholdStates. */
+    struct FChannelState
+    {
+        float Value = 0.f;
+        float MinValue = 0.f;
+        float MaxValue = 0.f;
+        int32 FirstThreshold = 0;
+        int32 NumThresholds = 0;
+    };
+
+    /** Runtime data of a threshold, with the bounds at which its fact turns true and false. */
+    struct FThresholdState
+    {
+        FName Fact;
+        int32 FactIndex = INDEX_NONE;
+        float EnterValue = 0.f;
+        float ExitValue = 0.f;
+        bool bTrueBelow = true;
+        bool bActive = false;
+    };
+
+    TArray<FChannelState> ChannelStates;
+    TArray<FThresholdState> ThresholdStates;
 };
@@ -28,6 +28,76 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
     FGOAPWorldState DesiredState;
 
+    /**
+     * @brief Rebuilds the packed desired state from @ref DesiredState.
+     *
+     * Called automatically after construction and editor changes. Call it manually
+     * after changing @ref DesiredState at runtime.
+     */
+    UFUNCTION(BlueprintCallable, Category = "GOAP")
+    void CompileFacts();
+
+    /** @return The bit-packed form of @ref DesiredState used by the planner. */
+    const FGOAPPackedState& GetPackedDesiredState() const { return PackedDesiredState; }
+
+    /**
+     * @return False if a fact of @ref DesiredState or @ref RelevanceConditions did not fit into
+     * the fact registry. Such a goal is treated as unsatisfiable and never picked.
+     */
+    bool HasCompleteFacts() const { return bFactsComplete; }
+
+    /**
+     * @brief Facts that must hold for this goal to be relevant.
+     *
+     * Compiled into a packed mask once, so checking them is a few bitwise operations.
+     * Most goals need nothing else, see @ref bUseCustomRelevance for the rest.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    TMap<FName, bool> RelevanceConditions;
+
+    /**
+     * @brief Whether @ref IsRelevant has to be called in addition to @ref RelevanceConditions.
+     *
+     * On by default so C++ overrides of IsRelevant_Implementation keep working. Clear it in
+     * goals that only use @ref RelevanceConditions, which then skip the call. Blueprint
+     * overrides are detected either way.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    bool bUseCustomRelevance = true;
+
+    /**
+     * @brief Facts that a custom @ref IsRelevant reads, besides @ref RelevanceConditions.
+     *
+     * Agents only reconsider their goal when a relevance fact changes. A custom check
+     * without any listed fact is assumed to read every fact.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    TArray<FName> RelevanceFacts;
+
+    /** @return Every fact relevance depends on, as a packed mask. */
+    const FGOAPPackedState& GetRelevanceMask() const { return RelevanceMask; }
+
+    /** @return The packed form of @ref RelevanceConditions. */
+    const FGOAPPackedState& GetPackedRelevanceConditions() const { return PackedRelevanceConditions; }
+
+    /** @return True if relevance needs the @ref IsRelevant call. */
+    bool HasCustomRelevance() const { return bHasCustomRelevance; }
+
+    /**
+     * @brief Fast relevance check used by agents.
+     *
+     * Tests the compiled conditions on the packed state and only calls @ref IsRelevant
+     * for goals with custom relevance logic.
+     *
+     * @param PackedState The agent's packed world state.
+     * @param WorldState The same state as a map, only read by custom logic.
+     * @return True if the goal should be considered.
+     */
+    bool IsRelevantFast(const FGOAPPackedState& PackedState, const FGOAPWorldState& WorldState) const
+    {
+        return bFactsComplete && PackedState.Satisfies(PackedRelevanceConditions) && (!bHasCustomRelevance || IsRelevant(WorldState));
+    }
+
     /**
      * @brief The goal's priority level.
      *
@@ -37,6 +107,23 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
     float Priority;
 
+    /**
+     * @brief How the planner searches for this goal.
+     *
+     * Default uses the agent's @ref AGOAPAgent::SearchMode. Regressive search is usually
+     * faster for goals that only a few actions of a large library contribute to.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    EGOAPSearchMode SearchMode = EGOAPSearchMode::Default;
+
+    /**
+     * @brief How quickly the agent has to replan while this goal is relevant.
+     *
+     * The replan scheduler serves the most urgent relevant goal of an agent first.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GOAP")
+    EGOAPUrgency Urgency = EGOAPUrgency::Normal;
+
     /**
      * @brief Returns the display name of the goal.
      *
@@ -50,12 +137,34 @@ public:
     /**
      * @brief Determines whether this goal is relevant given the current world state.
      *
-     * Override this in derived goals to add custom logic for when a goal should be considered.
-     * For example, a "Rest" goal might only be relevant if the agents energy is below a threshold.
+     * The default checks @ref RelevanceConditions. Override this in derived goals to add custom
+     * logic for when a goal should be considered, and leave @ref bUseCustomRelevance set in C++ overrides.
      *
      * @param WorldState The current world state as perceived by the agent.
      * @return True if the goal should be considered, false otherwise.
      */
     UFUNCTION(BlueprintNativeEvent, Category = "GOAP")
     bool IsRelevant(const FGOAPWorldState& WorldState) const;
+
+    virtual void PostInitProperties() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+    /** Packed copy of @ref DesiredState. */
+    FGOAPPackedState PackedDesiredState;
+
+    /** Packed facts of @ref RelevanceConditions and @ref RelevanceFacts. */
+    FGOAPPackedState RelevanceMask;
+
+    /** Packed copy of @ref RelevanceConditions. */
+    FGOAPPackedState PackedRelevanceConditions;
+
+    /** Compiled from @ref bUseCustomRelevance and Blueprint overrides of IsRelevant. */
+    bool bHasCustomRelevance = false;
+
+    /** Whether every fact was packed by the last @ref CompileFacts. */
+    bool bFactsComplete = true;
 };
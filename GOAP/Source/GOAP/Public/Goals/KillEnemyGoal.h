@@ -14,5 +14,4 @@ public:
 
     // Override from base goal
     virtual FString GetGoalName_Implementation() const override;
-    virtual bool IsRelevant_Implementation(const FGOAPWorldState& WorldState) const override;
 };
@@ -0,0 +1,288 @@
+// Google Benchmark suite for the planning core over generated domains.
+//
+// The search benchmarks take (facts, actions, branching) so one run shows how each of them
+// scales the planner. Counters report the work per plan: nodes expanded and generated,
+// the peak open list, the plan length and whether the domain was solved within the iteration limit.
+// The traced search and the trace write benchmarks show what EDebugLevel::Detailed costs.
+
+#include "GOAPCore/GOAPCore.h"
+#include "SyntheticDomain.h"
+#include <benchmark/benchmark.h>
+
+using namespace GOAPCore;
+
+namespace
+{
+    constexpr int32_t MaxIterations = 20000;
+
+    FSyntheticDomainParams GetParams(const benchmark::State& State)
+    {
+        FSyntheticDomainParams Params;
+        Params.NumFacts = (int32_t)State.range(0);
+        Params.NumActions = (int32_t)State.range(1);
+        Params.Branching = (int32_t)State.range(2);
+        return Params;
+    }
+
+    // Plans repeatedly on one domain with a warm search, like an agent replanning
+    void RunSearch(benchmark::State& State, ESearchMode Mode, EHeuristic Heuristic, const FSyntheticDomain& Domain,
+        EDebugLevel DebugLevel = EDebugLevel::None)
+    {
+        FPlanSearch Search;
+        int64_t NumExpanded = 0;
+        int64_t NumNodes = 0;
+        int64_t NumSolved = 0;
+        int32_t PeakOpen = 0;
+        size_t PlanLength = 0;
+
+        for (auto _ : State)
+        {
+            Search.Start(Domain.Actions, Domain.Start, Domain.Goal, DebugLevel, Mode, MaxIterations, Heuristic);
+            const ESearchStatus Status = Search.Step(MaxIterations);
+            benchmark::DoNotOptimize(Status);
+
+            NumExpanded += Search.GetNumIterations();
+            NumNodes += Search.GetNumNodes();
+            NumSolved += Status == ESearchStatus::Succeeded;
+            PeakOpen = Search.GetStats().PeakOpen;
+            PlanLength = Search.GetPlan().size();
+        }
+
+        State.SetItemsProcessed(NumExpanded);
+        State.counters["Expanded"] = benchmark::Counter((double)NumExpanded, benchmark::Counter::kAvgIterations);
+        State.counters["Nodes"] = benchmark::Counter((double)NumNodes, benchmark::Counter::kAvgIterations);
+        State.counters["Solved"] = benchmark::Counter((double)NumSolved, benchmark::Counter::kAvgIterations);
+        State.counters["PlanLength"] = (double)PlanLength;
+        State.counters["PeakOpen"] = (double)PeakOpen;
+    }
+
+    void BM_ForwardSearch(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+        RunSearch(State, ESearchMode::Forward, EHeuristic::FF, Domain);
+    }
+
+    void BM_RegressiveSearch(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+        RunSearch(State, ESearchMode::Regressive, EHeuristic::FF, Domain);
+    }
+
+    // Forward search recording every event into the trace buffer, compare with BM_ForwardSearch
+    void BM_TracedForwardSearch(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+        RunSearch(State, ESearchMode::Forward, EHeuristic::FF, Domain, EDebugLevel::Detailed);
+    }
+
+    void BM_TraceWrite(benchmark::State& State)
+    {
+        FTraceBuffer& Buffer = FTraceRegistry::Get().GetThreadBuffer();
+        FTraceEvent Event{ 0x9E3779B97F4A7C15ull, 1, ETraceEvent::Generate, EPruneReason::None, 1, 0, 3, 1.f, 2.f };
+        for (auto _ : State)
+        {
+            Buffer.Write(Event);
+            ++Event.Node;
+        }
+        benchmark::DoNotOptimize(Buffer.GetNumWritten());
+    }
+
+    // Same domain under each heuristic, range(3) is the EHeuristic value
+    void BM_Heuristic(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+        RunSearch(State, ESearchMode::Forward, (EHeuristic)State.range(3), Domain);
+    }
+
+    // Replans after one start fact flips each time, reusing the regressive graph
+    void BM_IncrementalReplan(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+
+        FPlanSearch Search;
+        FPackedState Current = Domain.Start;
+        int32_t Flip = 0;
+        int64_t NumReused = 0;
+
+        for (auto _ : State)
+        {
+            Current.SetFact(Flip, !(Current.Values[Flip >> 6] & (1ull << (Flip & 63))));
+            Flip = (Flip + 1) % 8;
+
+            NumReused += Search.StartIncremental(Domain.Actions, Current, Domain.Goal, EDebugLevel::None, MaxIterations, EHeuristic::Add);
+            benchmark::DoNotOptimize(Search.Step(MaxIterations));
+        }
+
+        State.counters["Reused"] = benchmark::Counter((double)NumReused, benchmark::Counter::kAvgIterations);
+    }
+
+    // Picks the best of four goals of different priority in one pass
+    void BM_MultiGoal(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+
+        std::vector<FGoalCandidate> Goals;
+        int32_t Priority = 10;
+        ForEachFact(Domain.Goal.Mask, [&](int32_t Fact)
+            {
+                FGoalCandidate Candidate;
+                Candidate.Goal.SetFact(Fact, true);
+                Candidate.Priority = (float)(Priority += 5);
+                Goals.push_back(Candidate);
+            });
+
+        FPlanSearch Search;
+        int64_t NumExpanded = 0;
+        for (auto _ : State)
+        {
+            Search.StartMultiGoal(Domain.Actions, Domain.Start, Goals.data(), (int32_t)Goals.size(), 0.5f,
+                EDebugLevel::None, MaxIterations, EHeuristic::Add);
+            benchmark::DoNotOptimize(Search.Step(MaxIterations));
+            NumExpanded += Search.GetNumIterations();
+        }
+
+        State.SetItemsProcessed(NumExpanded);
+        State.counters["Expanded"] = benchmark::Counter((double)NumExpanded, benchmark::Counter::kAvgIterations);
+    }
+
+    // One relaxed cost pass from the start state, the inner loop of the relaxed heuristics
+    void BM_RelaxedCosts(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+
+        FRelaxedHeuristic Heuristic;
+        Heuristic.Start(Domain.Actions, EHeuristic::FF, Domain.Start, false);
+        for (auto _ : State)
+        {
+            benchmark::DoNotOptimize(Heuristic.Evaluate(Domain.Start, Domain.Goal));
+        }
+    }
+
+    // Applicable actions of a child: full test against the incremental update through the precondition index
+    void BM_ComputeApplicable(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+
+        std::vector<FWord> Words(Domain.Actions.NumActionWords);
+        FPackedState Child = Domain.Start;
+        Child.SetFact(0, true);
+        for (auto _ : State)
+        {
+            Domain.Actions.ComputeApplicable(Child, Words.data());
+            benchmark::DoNotOptimize(Words.data());
+        }
+    }
+
+    void BM_UpdateApplicable(benchmark::State& State)
+    {
+        FSyntheticDomain Domain;
+        BuildSyntheticDomain(GetParams(State), Domain);
+
+        std::vector<FWord> ParentWords(Domain.Actions.NumActionWords);
+        std::vector<FWord> Words(Domain.Actions.NumActionWords);
+        Domain.Actions.ComputeApplicable(Domain.Start, ParentWords.data());
+        FPackedState Child = Domain.Start;
+        Child.SetFact(0, true);
+        for (auto _ : State)
+        {
+            Domain.Actions.UpdateApplicable(Domain.Start, Child, ParentWords.data(), Words.data());
+            benchmark::DoNotOptimize(Words.data());
+        }
+    }
+
+    void BM_BuildActionSet(benchmark::State& State)
+    {
+        const FSyntheticDomainParams Params = GetParams(State);
+        for (auto _ : State)
+        {
+            FSyntheticDomain Domain;
+            BuildSyntheticDomain(Params, Domain);
+            benchmark::DoNotOptimize(Domain.Actions.Signature);
+        }
+    }
+
+    void BM_ApplyHashed(benchmark::State& State)
+    {
+        FPackedState Effects;
+        Effects.SetFact(3, true);
+        Effects.SetFact(70, false);
+        Effects.SetFact(101, true);
+
+        FPackedState Base;
+        for (int32_t Fact = 0; Fact < GOAP_MAX_FACTS; Fact += 2)
+        {
+            Base.SetFact(Fact, (Fact & 4) != 0);
+        }
+        const FWord BaseHash = Base.GetHash();
+
+        for (auto _ : State)
+        {
+            FPackedState Child = Base;
+            FWord Hash = BaseHash;
+            Child.ApplyHashed(Effects, Hash);
+            benchmark::DoNotOptimize(Hash);
+        }
+    }
+
+    // Facts x actions x branching grid shared by the search benchmarks, with at least one achiever per fact
+    void SearchGrid(benchmark::internal::Benchmark* Bench)
+    {
+        Bench->ArgNames({ "Facts", "Actions", "Branching" });
+        for (int64_t NumFacts : { 32, 64, 128 })
+        {
+            for (int64_t NumActions : { NumFacts * 2, NumFacts * 8, NumFacts * 32 })
+            {
+                for (int64_t Branching : { 4, 16 })
+                {
+                    Bench->Args({ NumFacts, NumActions, Branching });
+                }
+            }
+        }
+        Bench->Unit(benchmark::kMicrosecond);
+    }
+
+    void ActionGrid(benchmark::internal::Benchmark* Bench)
+    {
+        Bench->ArgNames({ "Facts", "Actions", "Branching" });
+        for (int64_t NumActions : { 64, 256, 1024, 4096 })
+        {
+            Bench->Args({ 128, NumActions, 16 });
+        }
+    }
+}
+
+BENCHMARK(BM_ForwardSearch)->Apply(SearchGrid);
+BENCHMARK(BM_RegressiveSearch)->Apply(SearchGrid);
+BENCHMARK(BM_TracedForwardSearch)
+    ->ArgNames({ "Facts", "Actions", "Branching" })
+    ->Args({ 32, 256, 16 })
+    ->Args({ 128, 1024, 16 })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TraceWrite);
+BENCHMARK(BM_Heuristic)
+    ->ArgNames({ "Facts", "Actions", "Branching", "Heuristic" })
+    ->ArgsProduct({ { 32, 64 }, { 256 }, { 8 }, { 0, 1, 2, 3 } })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IncrementalReplan)
+    ->ArgNames({ "Facts", "Actions", "Branching" })
+    ->Args({ 32, 64, 4 })
+    ->Args({ 64, 256, 8 })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MultiGoal)
+    ->ArgNames({ "Facts", "Actions", "Branching" })
+    ->Args({ 32, 64, 4 })
+    ->Args({ 64, 256, 8 })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RelaxedCosts)->Apply(ActionGrid);
+BENCHMARK(BM_ComputeApplicable)->Apply(ActionGrid);
+BENCHMARK(BM_UpdateApplicable)->Apply(ActionGrid);
+BENCHMARK(BM_BuildActionSet)->Apply(ActionGrid)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ApplyHashed);
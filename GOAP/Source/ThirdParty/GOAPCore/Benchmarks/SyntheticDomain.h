@@ -0,0 +1,112 @@
+#pragma once
+
+#include "GOAPCore/GOAPCore.h"
+#include <algorithm>
+
+/// \file SyntheticDomain.h
+
+namespace GOAPCore
+{
+    /** Shape of a generated planning problem. */
+    struct FSyntheticDomainParams
+    {
+        /** Number of facts, at most GOAP_MAX_FACTS. */
+        int32_t NumFacts = 64;
+
+        /** Number of actions. */
+        int32_t NumActions = 256;
+
+        /** Number of actions without preconditions, i.e. the branching factor at the start state. */
+        int32_t Branching = 8;
+
+        /** Seed of the generator, the same parameters and seed always give the same domain. */
+        FWord Seed = 1;
+    };
+
+    /** A generated action set with a start state and a goal. */
+    struct FSyntheticDomain
+    {
+        FActionSet Actions;
+        FPackedState Start;
+        FPackedState Goal;
+    };
+
+    /**
+     * @brief Builds a random but solvable-by-construction planning problem.
+     *
+     * Facts are ordered and every action sets one fact true, requiring facts from just below
+     * it in that order, so the facts form layers the planner has to climb. Every fact has at
+     * least one achiever when there are as many actions as facts. Some actions also set a
+     * lower fact false, which forces the search to order its steps. Every fact starts false
+     * and the goal asks for a few facts from the top layer.
+     *
+     * @param Params The shape of the domain.
+     * @param Out Receives the domain.
+     */
+    inline void BuildSyntheticDomain(const FSyntheticDomainParams& Params, FSyntheticDomain& Out)
+    {
+        const int32_t NumFacts = std::min(std::max(Params.NumFacts, 8), (int32_t)GOAP_MAX_FACTS);
+        const int32_t NumActions = std::max(Params.NumActions, 1);
+        const int32_t Window = 8;
+
+        FWord Seed = Params.Seed * 0x9E3779B97F4A7C15ull;
+        auto NextRandom = [&Seed](int32_t Range)
+            {
+                Seed += 0x9E3779B97F4A7C15ull;
+                FWord Z = Seed;
+                Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+                return (int32_t)((Z ^ (Z >> 31)) % (FWord)Range);
+            };
+
+        // A few goal facts spread over the top quarter, never deleted so the goal stays stable
+        Out.Goal = FPackedState();
+        const int32_t NumGoalFacts = 4;
+        for (int32_t GoalFact = 0; GoalFact < NumGoalFacts; ++GoalFact)
+        {
+            Out.Goal.SetFact(NumFacts - 1 - GoalFact * (NumFacts / 4) / NumGoalFacts, true);
+        }
+
+        Out.Start = FPackedState();
+        for (int32_t Fact = 0; Fact < NumFacts; ++Fact)
+        {
+            Out.Start.SetFact(Fact, false);
+        }
+
+        // The first NumFacts actions cover one fact each, the free ones come right after them
+        const int32_t FirstFree = NumActions > NumFacts ? NumFacts : 0;
+
+        Out.Actions.Init(NumActions);
+        for (int32_t ActionIndex = 0; ActionIndex < NumActions; ++ActionIndex)
+        {
+            const int32_t Target = ActionIndex < NumFacts ? ActionIndex : NextRandom(NumFacts);
+            const bool bFree = Target == 0 || (ActionIndex >= FirstFree && ActionIndex < FirstFree + Params.Branching);
+
+            FPackedState Preconditions;
+            if (!bFree)
+            {
+                const int32_t Lowest = std::max(0, Target - Window);
+                const int32_t NumPreconditions = 1 + NextRandom(2);
+                for (int32_t Pre = 0; Pre < NumPreconditions; ++Pre)
+                {
+                    Preconditions.SetFact(Lowest + NextRandom(Target - Lowest), true);
+                }
+            }
+
+            FPackedState Effects;
+            Effects.SetFact(Target, true);
+            if (Target > 0 && NextRandom(4) == 0)
+            {
+                const int32_t Deleted = NextRandom(Target);
+                bool bGoalValue;
+                if (!Out.Goal.GetFact(Deleted, bGoalValue) && !Preconditions.GetFact(Deleted, bGoalValue))
+                {
+                    Effects.SetFact(Deleted, false);
+                }
+            }
+
+            Out.Actions.SetAction(ActionIndex, Preconditions, Effects, 1.f + (float)NextRandom(4));
+        }
+        Out.Actions.BuildIndices();
+    }
+}
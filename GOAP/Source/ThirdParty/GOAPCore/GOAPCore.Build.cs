@@ -0,0 +1,14 @@
+// Engine independent planning core, header only. CMakeLists.txt next to this file builds its tests and benchmarks.
+
+using System.IO;
+using UnrealBuildTool;
+
+public class GOAPCore : ModuleRules
+{
+	public GOAPCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		Type = ModuleType.External;
+
+		PublicSystemIncludePaths.Add(Path.Combine(ModuleDirectory, "include"));
+	}
+}
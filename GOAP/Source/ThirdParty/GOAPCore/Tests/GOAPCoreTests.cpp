@@ -0,0 +1,409 @@
+// Plain checks of the planning core, run by ctest. Returns non-zero if any check failed.
+
+#include "GOAPCore/GOAPCore.h"
+#include "TraceDecoder.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <sstream>
+#include <utility>
+
+using namespace GOAPCore;
+
+static int32_t GNumFailed = 0;
+
+#define GOAPCORE_CHECK(Condition) \
+    if (!(Condition)) \
+    { \
+        std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Condition); \
+        ++GNumFailed; \
+    }
+
+namespace
+{
+    enum EFact : int32_t
+    {
+        HasWeapon,
+        EnemyVisible,
+        HasBullets,
+        EnemyAlive,
+        IsExhausted,
+        IsPatrolling
+    };
+
+    enum EAction : int32_t
+    {
+        PickupWeapon,
+        ReloadWeapon,
+        Attack,
+        PutAwayWeapon,
+        Rest,
+        Patrol,
+        NumActions
+    };
+
+    FPackedState MakeState(std::initializer_list<std::pair<int32_t, bool>> Facts)
+    {
+        FPackedState State;
+        for (const std::pair<int32_t, bool>& Fact : Facts)
+        {
+            State.SetFact(Fact.first, Fact.second);
+        }
+        return State;
+    }
+
+    // Same facts, costs and conditions as the stock actions of the plugin
+    void BuildCombatDomain(FActionSet& Set)
+    {
+        Set.Init(NumActions);
+        Set.SetAction(PickupWeapon, MakeState({ { HasWeapon, false } }), MakeState({ { HasWeapon, true } }), 1.5f, "PickupWeapon");
+        Set.SetAction(ReloadWeapon, MakeState({ { HasWeapon, true }, { HasBullets, false } }), MakeState({ { HasBullets, true } }), 3.f, "ReloadWeapon");
+        Set.SetAction(Attack, MakeState({ { HasWeapon, true }, { EnemyVisible, true }, { HasBullets, true } }),
+            MakeState({ { EnemyAlive, false }, { EnemyVisible, false }, { HasBullets, false } }), 3.f, "Attack");
+        Set.SetAction(PutAwayWeapon, MakeState({ { HasWeapon, true }, { EnemyVisible, false } }), MakeState({ { HasWeapon, false } }), 3.f, "PutAwayWeapon");
+        Set.SetAction(Rest, MakeState({ { IsExhausted, true } }), MakeState({ { IsExhausted, false } }), 1.f, "Rest");
+        Set.SetAction(Patrol, MakeState({ { HasWeapon, false }, { IsExhausted, false } }), MakeState({ { IsPatrolling, true } }), 5.f, "Patrol");
+        Set.BuildIndices();
+    }
+
+    FPackedState MakeStart()
+    {
+        return MakeState({ { HasWeapon, false }, { EnemyVisible, true }, { HasBullets, false },
+            { EnemyAlive, true }, { IsExhausted, false }, { IsPatrolling, false } });
+    }
+
+    float PlanCost(const FActionSet& Set, const std::vector<int32_t>& Plan)
+    {
+        float Cost = 0.f;
+        for (int32_t ActionIndex : Plan)
+        {
+            Cost += Set.Costs[ActionIndex];
+        }
+        return Cost;
+    }
+
+    bool NearlyEqual(float A, float B)
+    {
+        return std::fabs(A - B) < 1e-4f;
+    }
+
+    void TestIncrementalHashes()
+    {
+        FPackedState State = MakeStart();
+        FWord Hash = State.GetHash();
+
+        State.ApplyHashed(MakeState({ { HasWeapon, true }, { EnemyAlive, false }, { 100, true } }), Hash);
+        GOAPCORE_CHECK(Hash == State.GetHash());
+
+        FPackedState Requirements = MakeState({ { EnemyAlive, false }, { IsPatrolling, true } });
+        FWord RequirementsHash = Requirements.GetHash();
+        const bool bRegressed = Requirements.RegressHashed(MakeState({ { EnemyAlive, false }, { HasBullets, false } }),
+            MakeState({ { HasWeapon, true }, { HasBullets, true } }), RequirementsHash);
+        GOAPCORE_CHECK(bRegressed);
+        GOAPCORE_CHECK(RequirementsHash == Requirements.GetHash());
+        GOAPCORE_CHECK(Requirements == MakeState({ { IsPatrolling, true }, { HasWeapon, true }, { HasBullets, true } }));
+    }
+
+    void TestSearchModes()
+    {
+        FActionSet Set;
+        BuildCombatDomain(Set);
+        const FPackedState Start = MakeStart();
+        const FPackedState KillGoal = MakeState({ { EnemyAlive, false } });
+
+        const ESearchMode Modes[] = { ESearchMode::Forward, ESearchMode::Regressive };
+        const EHeuristic Heuristics[] = { EHeuristic::GoalCount, EHeuristic::Max, EHeuristic::Add, EHeuristic::FF };
+        for (ESearchMode Mode : Modes)
+        {
+            for (EHeuristic Heuristic : Heuristics)
+            {
+                FPlanSearch Search;
+                Search.Start(Set, Start, KillGoal, EDebugLevel::None, Mode, 1000, Heuristic);
+                GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+
+                const std::vector<int32_t>& Plan = Search.GetPlan();
+                GOAPCORE_CHECK(Set.IsPlanValid(Start, KillGoal, Plan.data(), (int32_t)Plan.size()));
+                GOAPCORE_CHECK(NearlyEqual(PlanCost(Set, Plan), 7.5f));
+            }
+        }
+
+        // Already satisfied and unreachable goals are decided without expanding
+        FPlanSearch Search;
+        Search.Start(Set, Start, MakeState({ { EnemyVisible, true } }), EDebugLevel::None, ESearchMode::Forward, 1000);
+        GOAPCORE_CHECK(Search.GetStatus() == ESearchStatus::Succeeded && Search.GetPlan().empty());
+
+        Search.Start(Set, Start, MakeState({ { EnemyAlive, true }, { EnemyVisible, false }, { 40, true } }),
+            EDebugLevel::None, ESearchMode::Forward, 1000, EHeuristic::Max);
+        GOAPCORE_CHECK(Search.GetStatus() == ESearchStatus::Failed);
+    }
+
+    void TestIncremental()
+    {
+        FActionSet Set;
+        BuildCombatDomain(Set);
+        const FPackedState KillGoal = MakeState({ { EnemyAlive, false } });
+
+        FPlanSearch Search;
+        GOAPCORE_CHECK(!Search.StartIncremental(Set, MakeStart(), KillGoal, EDebugLevel::None, 1000));
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        GOAPCORE_CHECK(Search.GetPlan().size() == 3);
+
+        // Picking the weapon up only changes priorities, the graph is kept
+        FPackedState Armed = MakeStart();
+        Armed.SetFact(HasWeapon, true);
+        GOAPCORE_CHECK(Search.StartIncremental(Set, Armed, KillGoal, EDebugLevel::None, 1000));
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        GOAPCORE_CHECK(Search.GetPlan() == std::vector<int32_t>({ ReloadWeapon, Attack }));
+    }
+
+    void TestIncrementalStats()
+    {
+        FActionSet Set;
+        BuildCombatDomain(Set);
+        const FPackedState KillGoal = MakeState({ { EnemyAlive, false } });
+
+        FPlanSearch Search;
+        Search.StartIncremental(Set, MakeStart(), KillGoal, EDebugLevel::None, 2);
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Failed);
+        GOAPCORE_CHECK(Search.GetStats().Failure == ESearchFailure::IterationLimit);
+
+        // A reused graph reports the work of the replan alone and forgets the old failure
+        FPackedState Armed = MakeStart();
+        Armed.SetFact(HasWeapon, true);
+        GOAPCORE_CHECK(Search.StartIncremental(Set, Armed, KillGoal, EDebugLevel::None, 1000));
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        const FSearchStats& Stats = Search.GetStats();
+        GOAPCORE_CHECK(Stats.Failure == ESearchFailure::None);
+        GOAPCORE_CHECK(Stats.NodesExpanded == Search.GetNumIterations());
+        GOAPCORE_CHECK(Stats.NodesGenerated < Search.GetNumNodes());
+        GOAPCORE_CHECK(Stats.PeakClosed <= Search.GetNumNodes());
+
+        Armed.SetFact(HasBullets, false);
+        GOAPCORE_CHECK(Search.StartIncremental(Set, Armed, KillGoal, EDebugLevel::None, 1000));
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        GOAPCORE_CHECK(Search.GetStats().NodesExpanded == Search.GetNumIterations());
+
+        // Returning early on a satisfied goal leaves nothing behind either
+        GOAPCORE_CHECK(Search.StartIncremental(Set, MakeState({ { EnemyAlive, false } }), KillGoal, EDebugLevel::None, 1000));
+        GOAPCORE_CHECK(Search.GetStatus() == ESearchStatus::Succeeded);
+        GOAPCORE_CHECK(Search.GetStats().NodesExpanded == 0 && Search.GetStats().NodesGenerated == 0);
+        GOAPCORE_CHECK(Search.GetStats().Failure == ESearchFailure::None);
+    }
+
+    void TestMultiGoal()
+    {
+        FActionSet Set;
+        BuildCombatDomain(Set);
+
+        const FGoalCandidate Goals[] = {
+            { MakeState({ { EnemyAlive, false } }), 10.f },
+            { MakeState({ { IsPatrolling, true } }), 3.f }
+        };
+
+        FPlanSearch Search;
+        Search.StartMultiGoal(Set, MakeStart(), Goals, 2, 1.f, EDebugLevel::None, 1000, EHeuristic::Max);
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        GOAPCORE_CHECK(Search.GetGoalIndex() == 0);
+        GOAPCORE_CHECK(Search.GetGoal() == Goals[0].Goal);
+
+        // Expensive enough that patrolling wins
+        Search.StartMultiGoal(Set, MakeStart(), Goals, 2, 4.f, EDebugLevel::None, 1000, EHeuristic::Max);
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        GOAPCORE_CHECK(Search.GetGoalIndex() == 1);
+        GOAPCORE_CHECK(Search.GetPlan() == std::vector<int32_t>({ Patrol }));
+    }
+
+    void TestAnytime()
+    {
+        FActionSet Set;
+        BuildCombatDomain(Set);
+        const FPackedState Start = MakeStart();
+        const FPackedState KillGoal = MakeState({ { EnemyAlive, false } });
+
+        FPlanSearch Search;
+        Search.StartAnytime(Set, Start, KillGoal, 3.f, 1.f, EDebugLevel::None, ESearchMode::Forward, 1000, EHeuristic::Max);
+
+        int32_t NumSteps = 0;
+        while (Search.IsInProgress() && NumSteps++ < 100)
+        {
+            Search.Step(1 << 30);
+        }
+        GOAPCORE_CHECK(Search.GetStatus() == ESearchStatus::Succeeded);
+        GOAPCORE_CHECK(Search.GetNumSolutions() >= 1);
+        GOAPCORE_CHECK(NearlyEqual(Search.GetSuboptimalityBound(), 1.f));
+        GOAPCORE_CHECK(NearlyEqual(PlanCost(Set, Search.GetPlan()), 7.5f));
+
+        // Without a weight step it is plain weighted A*, done at the first plan
+        Search.StartAnytime(Set, Start, KillGoal, 2.f, 0.f, EDebugLevel::None, ESearchMode::Forward, 1000, EHeuristic::Max);
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        GOAPCORE_CHECK(Search.GetNumSolutions() == 1);
+        GOAPCORE_CHECK(PlanCost(Set, Search.GetPlan()) <= 2.f * 7.5f + 1e-3f);
+    }
+
+    void TestCancelAndBudget()
+    {
+        FActionSet Set;
+        BuildCombatDomain(Set);
+
+        FPlanSearch Search;
+        Search.Start(Set, MakeStart(), MakeState({ { EnemyAlive, false } }), EDebugLevel::None, ESearchMode::Forward, 1000);
+        GOAPCORE_CHECK(Search.Step(1) == ESearchStatus::InProgress);
+        GOAPCORE_CHECK(Search.GetNumIterations() == 1);
+
+        const std::atomic<bool> bCancelled{ true };
+        GOAPCORE_CHECK(Search.Step(1 << 30, 0.0, &bCancelled) == ESearchStatus::Failed);
+
+        Search.Reset();
+        GOAPCORE_CHECK(Search.GetStatus() == ESearchStatus::Idle && Search.GetActionSet() == nullptr);
+    }
+
+    void TestStats()
+    {
+        FActionSet Set;
+        BuildCombatDomain(Set);
+        const FPackedState KillGoal = MakeState({ { EnemyAlive, false } });
+
+        FPlanSearch Search;
+        Search.Start(Set, MakeStart(), KillGoal, EDebugLevel::None, ESearchMode::Forward, 1000);
+        Search.Step(1 << 30);
+        const FSearchStats& Stats = Search.GetStats();
+        GOAPCORE_CHECK(Stats.NodesExpanded == Search.GetNumIterations());
+        GOAPCORE_CHECK(Stats.NodesGenerated == Search.GetNumNodes());
+        GOAPCORE_CHECK(Stats.PeakOpen > 0 && Stats.PeakClosed > 0);
+        GOAPCORE_CHECK(Stats.Failure == ESearchFailure::None);
+
+        Search.Start(Set, MakeStart(), MakeState({ { 40, true } }), EDebugLevel::None, ESearchMode::Forward, 1000, EHeuristic::Max);
+        GOAPCORE_CHECK(Search.GetStats().Failure == ESearchFailure::Unreachable);
+
+        // Goal count never proves a goal unreachable, the open list has to run dry
+        Search.Start(Set, MakeStart(), MakeState({ { 40, true } }), EDebugLevel::None, ESearchMode::Forward, 1000);
+        Search.Step(1 << 30);
+        GOAPCORE_CHECK(Search.GetStats().Failure == ESearchFailure::Exhausted);
+
+        Search.Start(Set, MakeStart(), KillGoal, EDebugLevel::None, ESearchMode::Forward, 1);
+        Search.Step(1 << 30);
+        GOAPCORE_CHECK(Search.GetStats().Failure == ESearchFailure::IterationLimit);
+
+        const std::atomic<bool> bCancelled{ true };
+        Search.Start(Set, MakeStart(), KillGoal, EDebugLevel::None, ESearchMode::Forward, 1000);
+        Search.Step(1 << 30, 0.0, &bCancelled);
+        GOAPCORE_CHECK(Search.GetStats().Failure == ESearchFailure::Cancelled);
+    }
+
+    void TestTrace()
+    {
+        FActionSet Set;
+        BuildCombatDomain(Set);
+        const FPackedState KillGoal = MakeState({ { EnemyAlive, false } });
+        FTraceBuffer& Buffer = FTraceRegistry::Get().GetThreadBuffer();
+
+        // Below Detailed nothing is recorded
+        FPlanSearch Search;
+        const uint64_t NumWritten = Buffer.GetNumWritten();
+        Search.Start(Set, MakeStart(), KillGoal, EDebugLevel::Minimal, ESearchMode::Forward, 1000);
+        Search.Step(1 << 30);
+        GOAPCORE_CHECK(Search.GetSearchId() == 0 && Buffer.GetNumWritten() == NumWritten);
+
+        Search.Start(Set, MakeStart(), KillGoal, EDebugLevel::Detailed, ESearchMode::Forward, 1000);
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        const uint16_t ForwardId = Search.GetSearchId();
+        const FSearchStats ForwardStats = Search.GetStats();
+        const std::vector<int32_t> ForwardPlan = Search.GetPlan();
+
+        Search.Start(Set, MakeStart(), KillGoal, EDebugLevel::Detailed, ESearchMode::Regressive, 1000);
+        GOAPCORE_CHECK(Search.Step(1 << 30) == ESearchStatus::Succeeded);
+        const uint16_t RegressiveId = Search.GetSearchId();
+        GOAPCORE_CHECK(ForwardId != 0 && RegressiveId != 0 && ForwardId != RegressiveId);
+
+        // Round trip through a file, then rebuild the trees
+        FTraceData Captured;
+        FTraceRegistry::Get().Capture(Captured);
+        GOAPCORE_CHECK(WriteTraceFile("GOAPCoreTests.trace", Captured));
+        FTraceData Data;
+        GOAPCORE_CHECK(ReadTraceFile("GOAPCoreTests.trace", Data));
+        GOAPCORE_CHECK(Data.Events.size() == Captured.Events.size());
+        std::remove("GOAPCoreTests.trace");
+
+        std::vector<FDecodedSearch> Searches;
+        DecodeTrace(Data, Searches);
+        const FDecodedSearch* Forward = nullptr;
+        const FDecodedSearch* Regressive = nullptr;
+        for (const FDecodedSearch& Decoded : Searches)
+        {
+            Forward = Decoded.SearchId == ForwardId ? &Decoded : Forward;
+            Regressive = Decoded.SearchId == RegressiveId ? &Decoded : Regressive;
+        }
+        GOAPCORE_CHECK(Forward && Regressive);
+        if (!Forward || !Regressive)
+        {
+            return;
+        }
+
+        GOAPCORE_CHECK(Forward->Signature == Set.Signature && Forward->NumActions == NumActions && Forward->Root == 0);
+        GOAPCORE_CHECK(Forward->NumExpanded == ForwardStats.NodesExpanded);
+        GOAPCORE_CHECK(Forward->NumGenerated + 1 == ForwardStats.NodesGenerated);
+        GOAPCORE_CHECK(Forward->GoalNode != IndexNone);
+        GOAPCORE_CHECK(!Regressive->Prunes.empty());
+
+        // Walking back from the goal node gives the plan
+        std::vector<int32_t> Path;
+        for (int32_t Node = Forward->GoalNode; Node != Forward->Root && Forward->Nodes.count(Node); Node = Forward->Nodes.at(Node).Parent)
+        {
+            Path.insert(Path.begin(), Forward->Nodes.at(Node).Action);
+        }
+        GOAPCORE_CHECK(Path == ForwardPlan);
+
+        std::ostringstream Text;
+        WriteTraceText(Text, *Forward);
+        GOAPCORE_CHECK(Text.str().find("via Attack") != std::string::npos);
+        GOAPCORE_CHECK(Text.str().find("[goal]") != std::string::npos);
+
+        std::ostringstream Dot;
+        WriteTraceDot(Dot, Searches);
+        GOAPCORE_CHECK(Dot.str().find("digraph") == 0);
+
+        std::ostringstream Json;
+        WriteTraceJson(Json, Searches);
+        GOAPCORE_CHECK(Json.str().find("\"actionName\":\"Attack\"") != std::string::npos);
+    }
+
+    void TestLogSink()
+    {
+        static int32_t NumLines = 0;
+        FActionSet Set;
+        BuildCombatDomain(Set);
+
+        FPlanSearch Search;
+        Search.SetLogSink([](const char*) { ++NumLines; });
+        Search.Start(Set, MakeStart(), MakeState({ { EnemyAlive, false } }), EDebugLevel::None, ESearchMode::Forward, 1000);
+        Search.Step(1 << 30);
+        GOAPCORE_CHECK(NumLines == 0);
+
+        Search.Start(Set, MakeStart(), MakeState({ { EnemyAlive, false } }), EDebugLevel::Detailed, ESearchMode::Forward, 1000);
+        Search.Step(1 << 30);
+        GOAPCORE_CHECK(NumLines > 0);
+    }
+}
+
+int main()
+{
+    TestIncrementalHashes();
+    TestSearchModes();
+    TestIncremental();
+    TestIncrementalStats();
+    TestMultiGoal();
+    TestAnytime();
+    TestCancelAndBudget();
+    TestStats();
+    TestTrace();
+    TestLogSink();
+
+    if (GNumFailed > 0)
+    {
+        std::printf("%d check(s) failed\n", GNumFailed);
+        return 1;
+    }
+    std::printf("All GOAPCore checks passed\n");
+    return 0;
+}
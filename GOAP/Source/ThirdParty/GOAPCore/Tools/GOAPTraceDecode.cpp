@@ -0,0 +1,104 @@
+// Offline decoder for planner trace dumps.
+//
+// Usage: GOAPTraceDecode <trace file> [--format text|json|dot] [--search <id>] [--out <file>]
+// Rebuilds the search tree of every search in the dump, or of one search, and prints it.
+
+#include "TraceDecoder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace GOAPCore;
+
+namespace
+{
+    int PrintUsage()
+    {
+        std::cerr << "Usage: GOAPTraceDecode <trace file> [--format text|json|dot] [--search <id>] [--out <file>]\n";
+        return 2;
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    const char* InputPath = nullptr;
+    const char* OutputPath = nullptr;
+    std::string Format = "text";
+    int SearchFilter = -1;
+
+    for (int Arg = 1; Arg < Argc; ++Arg)
+    {
+        const bool bHasValue = Arg + 1 < Argc;
+        if (std::strcmp(Argv[Arg], "--format") == 0 && bHasValue)
+        {
+            Format = Argv[++Arg];
+        }
+        else if (std::strcmp(Argv[Arg], "--search") == 0 && bHasValue)
+        {
+            SearchFilter = std::atoi(Argv[++Arg]);
+        }
+        else if (std::strcmp(Argv[Arg], "--out") == 0 && bHasValue)
+        {
+            OutputPath = Argv[++Arg];
+        }
+        else if (!InputPath && Argv[Arg][0] != '-')
+        {
+            InputPath = Argv[Arg];
+        }
+        else
+        {
+            return PrintUsage();
+        }
+    }
+    if (!InputPath || (Format != "text" && Format != "json" && Format != "dot"))
+    {
+        return PrintUsage();
+    }
+
+    FTraceData Data;
+    if (!ReadTraceFile(InputPath, Data))
+    {
+        std::cerr << "Cannot read trace file " << InputPath << "\n";
+        return 1;
+    }
+
+    std::vector<FDecodedSearch> Searches;
+    DecodeTrace(Data, Searches);
+    if (SearchFilter >= 0)
+    {
+        Searches.erase(std::remove_if(Searches.begin(), Searches.end(),
+            [SearchFilter](const FDecodedSearch& Search) { return Search.SearchId != SearchFilter; }), Searches.end());
+    }
+
+    std::ofstream File;
+    if (OutputPath)
+    {
+        File.open(OutputPath);
+        if (!File)
+        {
+            std::cerr << "Cannot write " << OutputPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream& Out = OutputPath ? File : std::cout;
+
+    if (Format == "json")
+    {
+        WriteTraceJson(Out, Searches);
+    }
+    else if (Format == "dot")
+    {
+        WriteTraceDot(Out, Searches);
+    }
+    else
+    {
+        for (const FDecodedSearch& Search : Searches)
+        {
+            WriteTraceText(Out, Search);
+            Out << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,412 @@
+#pragma once
+
+#include "GOAPCore/Trace.h"
+#include <cstdarg>
+#include <cstdio>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/// \file TraceDecoder.h
+/// Rebuilds search trees from planner trace events and prints them as text, JSON or DOT.
+
+namespace GOAPCore
+{
+    /** A node of a decoded search, with the last edge and cost recorded for it. */
+    struct FDecodedNode
+    {
+        int32_t Parent = IndexNone;
+        int32_t Action = IndexNone;
+        FWord Hash = 0;
+        float G = 0.f;
+        float H = 0.f;
+
+        /** Position in expansion order, IndexNone if the node was never expanded. */
+        int32_t ExpandOrder = IndexNone;
+
+        /** Number of cheaper paths found to the node after it was generated. */
+        int32_t NumReopens = 0;
+
+        bool bGoal = false;
+    };
+
+    /** An action that was not expanded, see ETraceEvent::Prune. */
+    struct FDecodedPrune
+    {
+        int32_t Parent = IndexNone;
+        int32_t Action = IndexNone;
+        int32_t Node = IndexNone;
+        EPruneReason Reason = EPruneReason::None;
+    };
+
+    /** All events of one search. Events lost to the ring buffer leave nodes without a known parent. */
+    struct FDecodedSearch
+    {
+        uint16_t SearchId = 0;
+        FWord Signature = 0;
+        int32_t NumActions = 0;
+        int32_t Root = IndexNone;
+        int32_t GoalNode = IndexNone;
+
+        /** Candidate a multi-goal search reached, IndexNone otherwise. */
+        int32_t GoalCandidate = IndexNone;
+
+        int32_t NumExpanded = 0;
+        int32_t NumGenerated = 0;
+        int32_t NumReopened = 0;
+
+        /** Nodes by pool index. */
+        std::map<int32_t, FDecodedNode> Nodes;
+        std::vector<FDecodedPrune> Prunes;
+
+        /** Names of the search's action set, null if the dump did not know them. */
+        const std::vector<std::string>* ActionNames = nullptr;
+
+        /** @return The action's name, or its index when the name is unknown. */
+        std::string GetActionName(int32_t ActionIndex) const
+        {
+            if (ActionNames && ActionIndex >= 0 && ActionIndex < (int32_t)ActionNames->size() && !(*ActionNames)[ActionIndex].empty())
+            {
+                return (*ActionNames)[ActionIndex];
+            }
+            return "#" + std::to_string(ActionIndex);
+        }
+    };
+
+    inline const char* GetPruneReasonName(EPruneReason Reason)
+    {
+        switch (Reason)
+        {
+        case EPruneReason::UndoesSubgoal: return "undoes an open subgoal";
+        case EPruneReason::ContradictsSubgoal: return "preconditions contradict open subgoals";
+        case EPruneReason::Visited: return "already visited state";
+        case EPruneReason::CheaperQueued: return "cheaper path already queued";
+        case EPruneReason::Unreachable: return "goal unreachable from child";
+        case EPruneReason::UtilityBound: return "cannot beat the best goal";
+        default: return "none";
+        }
+    }
+
+    /**
+     * @brief Groups trace events by search and replays them into search trees.
+     *
+     * @param Data The events and action names of a dump. Must outlive the decoded searches.
+     * @param Out Receives one entry per search, in order of their first event.
+     */
+    inline void DecodeTrace(const FTraceData& Data, std::vector<FDecodedSearch>& Out)
+    {
+        std::unordered_map<uint16_t, size_t> SearchIndices;
+        for (const FTraceEvent& Event : Data.Events)
+        {
+            auto Found = SearchIndices.find(Event.SearchId);
+            if (Found == SearchIndices.end())
+            {
+                Found = SearchIndices.emplace(Event.SearchId, Out.size()).first;
+                Out.emplace_back();
+                Out.back().SearchId = Event.SearchId;
+            }
+            FDecodedSearch& Search = Out[Found->second];
+
+            switch (Event.Type)
+            {
+            case ETraceEvent::SearchStart:
+            {
+                Search.Signature = Event.Hash;
+                Search.NumActions = Event.Action;
+                Search.Root = Event.Node;
+                const auto Names = Data.ActionNames.find(Event.Hash);
+                Search.ActionNames = Names != Data.ActionNames.end() ? &Names->second : nullptr;
+
+                FDecodedNode& Root = Search.Nodes[Event.Node];
+                Root.G = Event.G;
+                Root.H = Event.H;
+                break;
+            }
+            case ETraceEvent::Generate:
+            {
+                FDecodedNode& Node = Search.Nodes[Event.Node];
+                Node.Parent = Event.Parent;
+                Node.Action = Event.Action;
+                Node.Hash = Event.Hash;
+                Node.G = Event.G;
+                Node.H = Event.H;
+                ++Search.NumGenerated;
+                break;
+            }
+            case ETraceEvent::Expand:
+            {
+                FDecodedNode& Node = Search.Nodes[Event.Node];
+                Node.Parent = Event.Parent;
+                Node.Action = Event.Action;
+                Node.Hash = Event.Hash;
+                Node.G = Event.G;
+                Node.H = Event.H;
+                if (Node.ExpandOrder == IndexNone)
+                {
+                    Node.ExpandOrder = Search.NumExpanded;
+                }
+                ++Search.NumExpanded;
+                break;
+            }
+            case ETraceEvent::Reopen:
+            {
+                FDecodedNode& Node = Search.Nodes[Event.Node];
+                Node.Parent = Event.Parent;
+                Node.Action = Event.Action;
+                Node.G = Event.G;
+                ++Node.NumReopens;
+                ++Search.NumReopened;
+                break;
+            }
+            case ETraceEvent::Prune:
+                Search.Prunes.push_back(FDecodedPrune{ Event.Parent, Event.Action, Event.Node, Event.Reason });
+                break;
+            case ETraceEvent::GoalFound:
+                Search.Nodes[Event.Node].bGoal = true;
+                Search.GoalNode = Event.Node;
+                Search.GoalCandidate = Event.Action;
+                break;
+            }
+        }
+    }
+
+    namespace TraceDecoderPrivate
+    {
+        inline std::string Format(const char* Format, ...)
+        {
+            char Buffer[256];
+            va_list Args;
+            va_start(Args, Format);
+            std::vsnprintf(Buffer, sizeof(Buffer), Format, Args);
+            va_end(Args);
+            return Buffer;
+        }
+
+        inline std::string Escape(const std::string& Text)
+        {
+            std::string Result;
+            for (char Char : Text)
+            {
+                if (Char == '"' || Char == '\\')
+                {
+                    Result += '\\';
+                }
+                if ((unsigned char)Char >= 0x20)
+                {
+                    Result += Char;
+                }
+            }
+            return Result;
+        }
+
+        /** Roots first, then every node after its parent, with its depth. */
+        inline void WalkTree(const FDecodedSearch& Search, std::vector<std::pair<int32_t, int32_t>>& OutOrder)
+        {
+            std::map<int32_t, std::vector<int32_t>> Children;
+            std::vector<std::pair<int32_t, int32_t>> Stack;
+            for (auto It = Search.Nodes.rbegin(); It != Search.Nodes.rend(); ++It)
+            {
+                const int32_t Parent = It->second.Parent;
+                if (Parent != IndexNone && Parent != It->first && Search.Nodes.count(Parent))
+                {
+                    Children[Parent].push_back(It->first);
+                }
+                else
+                {
+                    Stack.emplace_back(It->first, 0);
+                }
+            }
+
+            // Reopened nodes can close a cycle with stale parents, visit every node once
+            std::unordered_set<int32_t> Visited;
+            while (!Stack.empty())
+            {
+                const std::pair<int32_t, int32_t> Entry = Stack.back();
+                Stack.pop_back();
+                if (!Visited.insert(Entry.first).second)
+                {
+                    continue;
+                }
+                OutOrder.push_back(Entry);
+
+                const auto Found = Children.find(Entry.first);
+                if (Found != Children.end())
+                {
+                    for (int32_t Child : Found->second)
+                    {
+                        Stack.emplace_back(Child, Entry.second + 1);
+                    }
+                }
+            }
+        }
+    }
+
+    /** Prints a search as an indented tree, pruned actions listed under the node they were pruned at. */
+    inline void WriteTraceText(std::ostream& Out, const FDecodedSearch& Search)
+    {
+        using namespace TraceDecoderPrivate;
+
+        Out << Format("Search %u: %d actions, signature 0x%016llx, %d expanded, %d generated, %d reopened, %d pruned",
+            (unsigned)Search.SearchId, Search.NumActions, (unsigned long long)Search.Signature,
+            Search.NumExpanded, Search.NumGenerated, Search.NumReopened, (int32_t)Search.Prunes.size());
+        if (Search.GoalNode != IndexNone)
+        {
+            Out << Format(", goal node %d", Search.GoalNode);
+            if (Search.GoalCandidate != IndexNone)
+            {
+                Out << Format(" (candidate %d)", Search.GoalCandidate);
+            }
+        }
+        Out << "\n";
+
+        std::map<int32_t, std::vector<const FDecodedPrune*>> Prunes;
+        for (const FDecodedPrune& Prune : Search.Prunes)
+        {
+            Prunes[Prune.Parent].push_back(&Prune);
+        }
+
+        std::vector<std::pair<int32_t, int32_t>> Order;
+        WalkTree(Search, Order);
+        for (const std::pair<int32_t, int32_t>& Entry : Order)
+        {
+            const FDecodedNode& Node = Search.Nodes.at(Entry.first);
+            const std::string Indent((size_t)Entry.second * 2 + 2, ' ');
+
+            Out << Indent << Format("#%d ", Entry.first);
+            Out << (Node.Action != IndexNone ? "via " + Search.GetActionName(Node.Action) : std::string(Entry.first == Search.Root ? "root" : "?"));
+            Out << Format(" G=%.2f H=%.2f hash=0x%016llx", Node.G, Node.H, (unsigned long long)Node.Hash);
+            if (Node.ExpandOrder != IndexNone)
+            {
+                Out << Format(" [expanded %d]", Node.ExpandOrder + 1);
+            }
+            if (Node.NumReopens > 0)
+            {
+                Out << Format(" [reopened %d]", Node.NumReopens);
+            }
+            if (Node.bGoal)
+            {
+                Out << " [goal]";
+            }
+            Out << "\n";
+
+            const auto Found = Prunes.find(Entry.first);
+            if (Found != Prunes.end())
+            {
+                for (const FDecodedPrune* Prune : Found->second)
+                {
+                    Out << Indent << "  x " << Search.GetActionName(Prune->Action) << " pruned (" << GetPruneReasonName(Prune->Reason);
+                    if (Prune->Node != IndexNone)
+                    {
+                        Out << Format(", #%d", Prune->Node);
+                    }
+                    Out << ")\n";
+                }
+            }
+        }
+    }
+
+    /** Prints searches as one JSON document with their nodes and pruned actions. */
+    inline void WriteTraceJson(std::ostream& Out, const std::vector<FDecodedSearch>& Searches)
+    {
+        using namespace TraceDecoderPrivate;
+
+        Out << "{\"searches\":[";
+        for (size_t SearchIndex = 0; SearchIndex < Searches.size(); ++SearchIndex)
+        {
+            const FDecodedSearch& Search = Searches[SearchIndex];
+            Out << (SearchIndex ? "," : "") << "\n{";
+            Out << Format("\"id\":%u,\"signature\":\"0x%016llx\",\"actions\":%d,\"root\":%d,\"goal\":%d,\"goalCandidate\":%d,",
+                (unsigned)Search.SearchId, (unsigned long long)Search.Signature, Search.NumActions, Search.Root,
+                Search.GoalNode, Search.GoalCandidate);
+            Out << Format("\"expanded\":%d,\"generated\":%d,\"reopened\":%d,", Search.NumExpanded, Search.NumGenerated, Search.NumReopened);
+
+            Out << "\"nodes\":[";
+            bool bFirst = true;
+            for (const auto& Entry : Search.Nodes)
+            {
+                const FDecodedNode& Node = Entry.second;
+                Out << (bFirst ? "" : ",") << "\n  {";
+                Out << Format("\"index\":%d,\"parent\":%d,\"action\":%d,", Entry.first, Node.Parent, Node.Action);
+                Out << "\"actionName\":\"" << (Node.Action != IndexNone ? Escape(Search.GetActionName(Node.Action)) : "") << "\",";
+                Out << Format("\"g\":%g,\"h\":%g,\"hash\":\"0x%016llx\",\"expandOrder\":%d,\"reopens\":%d,\"goal\":%s}",
+                    Node.G, Node.H, (unsigned long long)Node.Hash, Node.ExpandOrder, Node.NumReopens, Node.bGoal ? "true" : "false");
+                bFirst = false;
+            }
+            Out << "],\"prunes\":[";
+
+            bFirst = true;
+            for (const FDecodedPrune& Prune : Search.Prunes)
+            {
+                Out << (bFirst ? "" : ",") << "\n  {";
+                Out << Format("\"parent\":%d,\"action\":%d,\"node\":%d,", Prune.Parent, Prune.Action, Prune.Node);
+                Out << "\"actionName\":\"" << Escape(Search.GetActionName(Prune.Action)) << "\",";
+                Out << "\"reason\":\"" << GetPruneReasonName(Prune.Reason) << "\"}";
+                bFirst = false;
+            }
+            Out << "]}";
+        }
+        Out << "\n]}\n";
+    }
+
+    /**
+     * @brief Prints searches as a Graphviz digraph, one cluster per search.
+     *
+     * Expanded nodes are filled, goal nodes drawn double. Actions pruned because they led to
+     * a known node are dashed edges to it.
+     */
+    inline void WriteTraceDot(std::ostream& Out, const std::vector<FDecodedSearch>& Searches)
+    {
+        using namespace TraceDecoderPrivate;
+
+        Out << "digraph GOAPTrace {\n  node [shape=box, fontname=\"Helvetica\", fontsize=10];\n  edge [fontname=\"Helvetica\", fontsize=9];\n";
+        for (const FDecodedSearch& Search : Searches)
+        {
+            const unsigned Id = Search.SearchId;
+            Out << Format("  subgraph cluster_%u {\n    label=\"Search %u\";\n", Id, Id);
+
+            for (const auto& Entry : Search.Nodes)
+            {
+                const FDecodedNode& Node = Entry.second;
+                Out << Format("    s%u_n%d [label=\"#%d\\nG=%.2f H=%.2f", Id, Entry.first, Entry.first, Node.G, Node.H);
+                if (Node.ExpandOrder != IndexNone)
+                {
+                    Out << Format("\\nexpanded %d", Node.ExpandOrder + 1);
+                }
+                Out << "\"";
+                if (Node.ExpandOrder != IndexNone)
+                {
+                    Out << ", style=filled, fillcolor=lightgrey";
+                }
+                if (Node.bGoal)
+                {
+                    Out << ", peripheries=2, color=darkgreen";
+                }
+                Out << "];\n";
+            }
+
+            for (const auto& Entry : Search.Nodes)
+            {
+                const FDecodedNode& Node = Entry.second;
+                if (Node.Parent != IndexNone && Search.Nodes.count(Node.Parent))
+                {
+                    Out << Format("    s%u_n%d -> s%u_n%d", Id, Node.Parent, Id, Entry.first)
+                        << " [label=\"" << Escape(Search.GetActionName(Node.Action)) << "\"];\n";
+                }
+            }
+
+            for (const FDecodedPrune& Prune : Search.Prunes)
+            {
+                if (Prune.Node != IndexNone && Search.Nodes.count(Prune.Parent) && Search.Nodes.count(Prune.Node))
+                {
+                    Out << Format("    s%u_n%d -> s%u_n%d", Id, Prune.Parent, Id, Prune.Node)
+                        << " [style=dashed, color=grey, label=\"" << Escape(Search.GetActionName(Prune.Action)) << "\"];\n";
+                }
+            }
+            Out << "  }\n";
+        }
+        Out << "}\n";
+    }
+}
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "GOAPCore/Types.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+/// \file ActionSet.h
+
+namespace GOAPCore
+{
+    /**
+     * @brief Flat, immutable planning data for a list of actions.
+     *
+     * Holds the packed preconditions, effects and costs of every action plus inverted indices
+     * from facts to the actions that read or write them, so the planner only has to look at
+     * actions that can actually change the outcome of an expansion. Action indices match the
+     * index in the list the set was built from.
+     *
+     * Filled with @ref Init, one @ref SetAction per non-null action and @ref BuildIndices.
+     */
+    struct FActionSet
+    {
+        /** Packed preconditions per action. */
+        std::vector<FPackedState> Preconditions;
+
+        /** Packed effects per action. */
+        std::vector<FPackedState> Effects;
+
+        /** Cost per action. */
+        std::vector<float> Costs;
+
+        /** Name per action, for logging without touching the actions. */
+        std::vector<std::string> ActionNames;
+
+        /** Number of actions, including null entries that are never used. */
+        int32_t NumActions = 0;
+
+        /** Number of 64-bit words in a bitset with one bit per action. */
+        int32_t NumActionWords = 0;
+
+        /** Bitset of the non-null actions. */
+        std::vector<FWord> ValidActions;
+
+        /** Number of precondition facts per action, used by the relaxed heuristics. */
+        std::vector<int32_t> PreconditionCounts;
+
+        /**
+         * @brief Hash of every action's preconditions, effects and cost, in order.
+         *
+         * Two agents whose action lists have the same signature get identical plans for the
+         * same start state and goal, which is what lets them share cached plans.
+         */
+        FWord Signature = 0;
+
+        /**
+         * @brief Actions whose preconditions mention a fact, in compressed rows.
+         *
+         * The actions for fact F are PreconditionActions[PreconditionOffsets[F] .. PreconditionOffsets[F + 1]).
+         */
+        std::vector<int32_t> PreconditionOffsets;
+        std::vector<int32_t> PreconditionActions;
+
+        /**
+         * @brief Actions whose effects set a fact to a value, in compressed rows.
+         *
+         * The row for fact F with value V has index F * 2 + V, layout as for @ref PreconditionOffsets.
+         */
+        std::vector<int32_t> EffectOffsets;
+        std::vector<int32_t> EffectActions;
+
+        /**
+         * @brief Clears the set to a number of null actions.
+         *
+         * @param InNumActions Number of actions the set will index.
+         */
+        void Init(int32_t InNumActions)
+        {
+            NumActions = InNumActions;
+            NumActionWords = (NumActions + 63) / 64;
+
+            Preconditions.assign(NumActions, FPackedState());
+            Effects.assign(NumActions, FPackedState());
+            Costs.assign(NumActions, 0.f);
+            ActionNames.assign(NumActions, std::string());
+            PreconditionCounts.assign(NumActions, 0);
+            ValidActions.assign(NumActionWords, 0);
+            Signature = 0;
+        }
+
+        /**
+         * @brief Fills in one action, entries that are never set stay null and are never planned with.
+         *
+         * @param ActionIndex Index of the action, below the count given to @ref Init.
+         * @param InPreconditions The packed preconditions.
+         * @param InEffects The packed effects.
+         * @param Cost The action's cost.
+         * @param Name Name used in planner logs, may be null.
+         */
+        void SetAction(int32_t ActionIndex, const FPackedState& InPreconditions, const FPackedState& InEffects, float Cost, const char* Name = nullptr)
+        {
+            Preconditions[ActionIndex] = InPreconditions;
+            Effects[ActionIndex] = InEffects;
+            Costs[ActionIndex] = Cost;
+            ActionNames[ActionIndex] = Name ? Name : "";
+            PreconditionCounts[ActionIndex] = 0;
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                PreconditionCounts[ActionIndex] += CountBits(InPreconditions.Mask[W]);
+            }
+            ValidActions[ActionIndex >> 6] |= 1ull << (ActionIndex & 63);
+        }
+
+        /** Computes the signature and the inverted indices once every action is set. */
+        void BuildIndices()
+        {
+            // The packed structs are plain words, so the arrays can be hashed as raw memory
+            Signature = HashBytes(ValidActions.data(), ValidActions.size() * sizeof(FWord), (FWord)NumActions);
+            Signature = HashBytes(Preconditions.data(), Preconditions.size() * sizeof(FPackedState), Signature);
+            Signature = HashBytes(Effects.data(), Effects.size() * sizeof(FPackedState), Signature);
+            Signature = HashBytes(Costs.data(), Costs.size() * sizeof(float), Signature);
+
+            // Count row sizes first so both indices are filled in one flat array each
+            PreconditionOffsets.assign(GOAP_MAX_FACTS + 1, 0);
+            EffectOffsets.assign(GOAP_MAX_FACTS * 2 + 1, 0);
+
+            for (int32_t ActionIndex = 0; ActionIndex < NumActions; ++ActionIndex)
+            {
+                if (!IsValidAction(ActionIndex)) continue;
+
+                ForEachFact(Preconditions[ActionIndex].Mask, [this](int32_t Fact) { ++PreconditionOffsets[Fact + 1]; });
+
+                const FPackedState& Effect = Effects[ActionIndex];
+                ForEachFact(Effect.Mask, [this, &Effect](int32_t Fact)
+                    {
+                        const int32_t Value = (int32_t)((Effect.Values[Fact >> 6] >> (Fact & 63)) & 1);
+                        ++EffectOffsets[Fact * 2 + Value + 1];
+                    });
+            }
+
+            for (size_t Row = 1; Row < PreconditionOffsets.size(); ++Row)
+            {
+                PreconditionOffsets[Row] += PreconditionOffsets[Row - 1];
+            }
+            for (size_t Row = 1; Row < EffectOffsets.size(); ++Row)
+            {
+                EffectOffsets[Row] += EffectOffsets[Row - 1];
+            }
+
+            PreconditionActions.resize(PreconditionOffsets.back());
+            EffectActions.resize(EffectOffsets.back());
+
+            std::vector<int32_t> PreconditionCursor(PreconditionOffsets.begin(), PreconditionOffsets.end() - 1);
+            std::vector<int32_t> EffectCursor(EffectOffsets.begin(), EffectOffsets.end() - 1);
+
+            for (int32_t ActionIndex = 0; ActionIndex < NumActions; ++ActionIndex)
+            {
+                if (!IsValidAction(ActionIndex)) continue;
+
+                ForEachFact(Preconditions[ActionIndex].Mask, [&](int32_t Fact)
+                    {
+                        PreconditionActions[PreconditionCursor[Fact]++] = ActionIndex;
+                    });
+
+                const FPackedState& Effect = Effects[ActionIndex];
+                ForEachFact(Effect.Mask, [&](int32_t Fact)
+                    {
+                        const int32_t Value = (int32_t)((Effect.Values[Fact >> 6] >> (Fact & 63)) & 1);
+                        EffectActions[EffectCursor[Fact * 2 + Value]++] = ActionIndex;
+                    });
+            }
+        }
+
+        /** @return True if an action was set, false for null entries. */
+        bool IsValidAction(int32_t ActionIndex) const
+        {
+            return (ValidActions[ActionIndex >> 6] & (1ull << (ActionIndex & 63))) != 0;
+        }
+
+        /** @return The action's name for logging, empty if it has none. */
+        const char* GetActionName(int32_t ActionIndex) const
+        {
+            return ActionNames[ActionIndex].c_str();
+        }
+
+        /**
+         * @brief Computes which actions are applicable in a state by testing every action.
+         *
+         * @param State The state to test.
+         * @param OutWords Bitset of NumActionWords words receiving the applicable actions.
+         */
+        void ComputeApplicable(const FPackedState& State, FWord* OutWords) const
+        {
+            for (int32_t W = 0; W < NumActionWords; ++W)
+            {
+                FWord Candidates = ValidActions[W];
+                FWord Applicable = 0;
+                while (Candidates)
+                {
+                    const int32_t Bit = CountTrailingZeros(Candidates);
+                    Candidates &= Candidates - 1;
+                    if (State.Satisfies(Preconditions[W * 64 + Bit]))
+                    {
+                        Applicable |= 1ull << Bit;
+                    }
+                }
+                OutWords[W] = Applicable;
+            }
+        }
+
+        /**
+         * @brief Derives the applicable actions of a child from those of its parent.
+         *
+         * Only actions whose preconditions mention a fact that differs between the two states
+         * are tested again, all other actions keep the parent's answer.
+         *
+         * @param ParentState The parent state.
+         * @param ChildState The child state.
+         * @param ParentWords The applicable bitset of the parent.
+         * @param OutWords Bitset of NumActionWords words receiving the child's applicable actions.
+         */
+        void UpdateApplicable(const FPackedState& ParentState, const FPackedState& ChildState,
+            const FWord* ParentWords, FWord* OutWords) const
+        {
+            std::memcpy(OutWords, ParentWords, NumActionWords * sizeof(FWord));
+
+            // Facts that became known or flipped value
+            FWord Changed[GOAP_FACT_WORDS];
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                Changed[W] = (ParentState.Mask[W] ^ ChildState.Mask[W]) | (ParentState.Values[W] ^ ChildState.Values[W]);
+            }
+
+            ForEachFact(Changed, [&](int32_t Fact)
+                {
+                    for (int32_t Cursor = PreconditionOffsets[Fact]; Cursor < PreconditionOffsets[Fact + 1]; ++Cursor)
+                    {
+                        const int32_t ActionIndex = PreconditionActions[Cursor];
+                        const FWord Bit = 1ull << (ActionIndex & 63);
+                        if (ChildState.Satisfies(Preconditions[ActionIndex]))
+                        {
+                            OutWords[ActionIndex >> 6] |= Bit;
+                        }
+                        else
+                        {
+                            OutWords[ActionIndex >> 6] &= ~Bit;
+                        }
+                    }
+                });
+        }
+
+        /**
+         * @brief Collects the actions that set at least one of the required facts to its required value.
+         *
+         * @param Requirements The partial state of open subgoals.
+         * @param OutWords Bitset of NumActionWords words receiving the candidate actions.
+         */
+        void ComputeAchievers(const FPackedState& Requirements, FWord* OutWords) const
+        {
+            std::memset(OutWords, 0, NumActionWords * sizeof(FWord));
+
+            ForEachFact(Requirements.Mask, [&](int32_t Fact)
+                {
+                    const int32_t Value = (int32_t)((Requirements.Values[Fact >> 6] >> (Fact & 63)) & 1);
+                    const int32_t Row = Fact * 2 + Value;
+                    for (int32_t Cursor = EffectOffsets[Row]; Cursor < EffectOffsets[Row + 1]; ++Cursor)
+                    {
+                        const int32_t ActionIndex = EffectActions[Cursor];
+                        OutWords[ActionIndex >> 6] |= 1ull << (ActionIndex & 63);
+                    }
+                });
+        }
+
+        /**
+         * @brief Simulates a plan to check it still reaches the goal.
+         *
+         * @param Start The state the plan would start from.
+         * @param Goal The goal the plan has to reach.
+         * @param ActionIndices The plan, in execution order.
+         * @param NumIndices Number of actions in the plan.
+         * @return True if every action's preconditions hold when it runs and the final state satisfies the goal.
+         */
+        bool IsPlanValid(const FPackedState& Start, const FPackedState& Goal, const int32_t* ActionIndices, int32_t NumIndices) const
+        {
+            FPackedState State = Start;
+            for (int32_t Step = 0; Step < NumIndices; ++Step)
+            {
+                const int32_t ActionIndex = ActionIndices[Step];
+                if (ActionIndex < 0 || ActionIndex >= NumActions || !IsValidAction(ActionIndex))
+                {
+                    return false;
+                }
+
+                if (!State.Satisfies(Preconditions[ActionIndex]))
+                {
+                    return false;
+                }
+                State.Apply(Effects[ActionIndex]);
+            }
+            return State.Satisfies(Goal);
+        }
+
+    private:
+        /** 64-bit FNV-1a over raw memory, chained through the seed. */
+        static FWord HashBytes(const void* Data, size_t NumBytes, FWord Seed)
+        {
+            FWord Hash = 0xCBF29CE484222325ull ^ Seed;
+            const unsigned char* Bytes = (const unsigned char*)Data;
+            for (size_t Index = 0; Index < NumBytes; ++Index)
+            {
+                Hash = (Hash ^ Bytes[Index]) * 0x100000001B3ull;
+            }
+            return Hash;
+        }
+    };
+}
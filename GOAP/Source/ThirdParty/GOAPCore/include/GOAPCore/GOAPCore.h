@@ -0,0 +1,11 @@
+#pragma once
+
+/// \file GOAPCore.h
+/// Includes the whole engine independent planning core.
+
+#include "GOAPCore/Types.h"
+#include "GOAPCore/ActionSet.h"
+#include "GOAPCore/Search.h"
+#include "GOAPCore/Heuristic.h"
+#include "GOAPCore/Trace.h"
+#include "GOAPCore/PlanSearch.h"
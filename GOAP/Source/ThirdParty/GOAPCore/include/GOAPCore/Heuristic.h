@@ -0,0 +1,324 @@
+#pragma once
+
+#include "GOAPCore/Types.h"
+#include "GOAPCore/ActionSet.h"
+#include <algorithm>
+#include <vector>
+
+/// \file Heuristic.h
+
+namespace GOAPCore
+{
+    /**
+     * @brief Estimate of the remaining plan cost used to guide the search.
+     *
+     * Same values as the engine side EGOAPHeuristic.
+     */
+    enum class EHeuristic : uint8_t
+    {
+        /** Number of unsatisfied goal facts. Cheap, but blind to action costs. */
+        GoalCount,
+
+        /** Cost of the most expensive goal fact in the relaxed problem. Admissible, plans stay optimal. */
+        Max,
+
+        /** Sum of the relaxed costs of the goal facts. Well informed but may overestimate. */
+        Add,
+
+        /** Cost of a relaxed plan without repeated actions. Usually the best guidance, may overestimate. */
+        FF
+    };
+
+    /**
+     * @brief Delete-relaxed cost estimates for the planner.
+     *
+     * The relaxed problem ignores that effects can overwrite facts, so every (fact, value)
+     * literal that was reached stays true. Literal costs are then found with a Dijkstra-like
+     * pass over the compiled actions: an action fires once all its precondition literals are
+     * reached, for its cost plus the max (h_max) or sum (h_add, h_FF) of their costs.
+     *
+     * Forward nodes measure their own state against the goal, so the pass runs per node and
+     * stops as soon as every goal literal is settled. Regressive nodes are all measured from
+     * the current state, so the pass runs once per search and a node only looks up its subgoals.
+     */
+    struct FRelaxedHeuristic
+    {
+        /** Returned for nodes whose goal cannot be reached even in the relaxed problem. */
+        static constexpr float Unreachable = MaxFloat;
+
+        /**
+         * @brief Prepares the heuristic for one search.
+         *
+         * @param InActionSet The compiled actions, must outlive the search.
+         * @param InMode The estimate to compute, GoalCount is handled by the caller.
+         * @param Current The current packed world state.
+         * @param bInRegressive True if nodes are subgoal sets measured against Current.
+         */
+        void Start(const FActionSet& InActionSet, EHeuristic InMode, const FPackedState& Current, bool bInRegressive)
+        {
+            ActionSet = &InActionSet;
+            Mode = InMode;
+            bRegressive = bInRegressive;
+
+            PreconditionCosts.resize(ActionSet->NumActions);
+            RemainingPreconditions.resize(ActionSet->NumActions);
+            UsedActions.resize(ActionSet->NumActionWords);
+
+            // Every regressive node is measured from the same state, settle all literals once
+            if (bRegressive)
+            {
+                ComputeCosts(Current, nullptr);
+            }
+        }
+
+        /**
+         * @brief Estimates the remaining cost of a node.
+         *
+         * @param NodeState The node's state (forward) or open subgoals (regressive).
+         * @param Goal The goal, only read by forward searches.
+         * @return The estimate, or @ref Unreachable.
+         */
+        float Evaluate(const FPackedState& NodeState, const FPackedState& Goal)
+        {
+            if (bRegressive)
+            {
+                return Aggregate(NodeState);
+            }
+
+            ComputeCosts(NodeState, &Goal);
+            return Aggregate(Goal);
+        }
+
+        /**
+         * @brief Computes the relaxed cost of every literal reachable from a state.
+         *
+         * @param State The facts that hold at zero cost.
+         * @param Target Literals to settle before stopping early, or null to settle every literal.
+         */
+        void ComputeCosts(const FPackedState& State, const FPackedState* Target = nullptr)
+        {
+            const FActionSet& Set = *ActionSet;
+
+            for (int32_t Literal = 0; Literal < GOAP_MAX_FACTS * 2; ++Literal)
+            {
+                LiteralCosts[Literal] = Unreachable;
+                Supporters[Literal] = IndexNone;
+                bSettled[Literal] = false;
+            }
+            Queue.clear();
+
+            // Fires an action whose preconditions are all settled, lowering the cost of its effects
+            auto FireAction = [this, &Set](int32_t ActionIndex)
+                {
+                    const float Cost = Set.Costs[ActionIndex] + PreconditionCosts[ActionIndex];
+                    const FPackedState& Effects = Set.Effects[ActionIndex];
+                    ForEachFact(Effects.Mask, [&](int32_t Fact)
+                        {
+                            const int32_t Literal = GetLiteral(Effects, Fact);
+                            if (Cost < LiteralCosts[Literal])
+                            {
+                                LiteralCosts[Literal] = Cost;
+                                Supporters[Literal] = ActionIndex;
+                                PushLiteral(FLiteralEntry{ Cost, Literal });
+                            }
+                        });
+                };
+
+            ForEachFact(State.Mask, [&](int32_t Fact)
+                {
+                    const int32_t Literal = GetLiteral(State, Fact);
+                    LiteralCosts[Literal] = 0.f;
+                    PushLiteral(FLiteralEntry{ 0.f, Literal });
+                });
+
+            for (int32_t ActionIndex = 0; ActionIndex < Set.NumActions; ++ActionIndex)
+            {
+                PreconditionCosts[ActionIndex] = 0.f;
+                RemainingPreconditions[ActionIndex] = Set.PreconditionCounts[ActionIndex];
+                if (RemainingPreconditions[ActionIndex] == 0 && Set.IsValidAction(ActionIndex))
+                {
+                    FireAction(ActionIndex);
+                }
+            }
+
+            int32_t TargetLeft = std::numeric_limits<int32_t>::max();
+            if (Target)
+            {
+                TargetLeft = 0;
+                ForEachFact(Target->Mask, [&TargetLeft](int32_t) { ++TargetLeft; });
+                if (TargetLeft == 0)
+                {
+                    return;
+                }
+            }
+
+            while (!Queue.empty())
+            {
+                const FLiteralEntry Entry = PopLiteral();
+                if (bSettled[Entry.Literal] || Entry.Cost > LiteralCosts[Entry.Literal])
+                {
+                    continue; // stale entry
+                }
+                bSettled[Entry.Literal] = true;
+
+                const int32_t Fact = Entry.Literal >> 1;
+                if (Target && (Target->Mask[Fact >> 6] & (1ull << (Fact & 63))) && GetLiteral(*Target, Fact) == Entry.Literal)
+                {
+                    if (--TargetLeft == 0)
+                    {
+                        return; // every goal literal is settled, the rest cannot change the estimate
+                    }
+                }
+
+                // Actions requiring this literal move one precondition closer to firing
+                for (int32_t Cursor = Set.PreconditionOffsets[Fact]; Cursor < Set.PreconditionOffsets[Fact + 1]; ++Cursor)
+                {
+                    const int32_t ActionIndex = Set.PreconditionActions[Cursor];
+                    if (GetLiteral(Set.Preconditions[ActionIndex], Fact) != Entry.Literal)
+                    {
+                        continue;
+                    }
+
+                    PreconditionCosts[ActionIndex] = Mode == EHeuristic::Max
+                        ? std::max(PreconditionCosts[ActionIndex], Entry.Cost)
+                        : PreconditionCosts[ActionIndex] + Entry.Cost;
+
+                    if (--RemainingPreconditions[ActionIndex] == 0)
+                    {
+                        FireAction(ActionIndex);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Estimates the cost of reaching a target from the last computed literal costs.
+         *
+         * Lets a caller measure one state against several goals with a single cost pass.
+         *
+         * @param Target The facts to reach.
+         * @return The estimate, or @ref Unreachable.
+         */
+        float Aggregate(const FPackedState& Target)
+        {
+            if (Mode == EHeuristic::FF)
+            {
+                return RelaxedPlanCost(Target);
+            }
+
+            float Estimate = 0.f;
+            bool bReachable = true;
+            ForEachFact(Target.Mask, [&](int32_t Fact)
+                {
+                    const float Cost = LiteralCosts[GetLiteral(Target, Fact)];
+                    bReachable &= Cost != Unreachable;
+                    Estimate = Mode == EHeuristic::Max ? std::max(Estimate, Cost) : Estimate + Cost;
+                });
+            return bReachable ? Estimate : Unreachable;
+        }
+
+        EHeuristic GetMode() const { return Mode; }
+
+    private:
+        /** Cost of the relaxed plan that reaches the target through the best supporters. */
+        float RelaxedPlanCost(const FPackedState& Target)
+        {
+            const FActionSet& Set = *ActionSet;
+            std::fill(UsedActions.begin(), UsedActions.end(), 0);
+
+            // Walk back from the target through the cheapest supporters, counting each action once
+            bool bReachable = true;
+            Worklist.clear();
+            ForEachFact(Target.Mask, [&](int32_t Fact)
+                {
+                    const int32_t Literal = GetLiteral(Target, Fact);
+                    bReachable &= LiteralCosts[Literal] != Unreachable;
+                    Worklist.push_back(Literal);
+                });
+            if (!bReachable)
+            {
+                return Unreachable;
+            }
+
+            float Estimate = 0.f;
+            for (size_t Cursor = 0; Cursor < Worklist.size(); ++Cursor)
+            {
+                const int32_t ActionIndex = Supporters[Worklist[Cursor]];
+                if (ActionIndex == IndexNone)
+                {
+                    continue;
+                }
+
+                FWord& Word = UsedActions[ActionIndex >> 6];
+                const FWord Bit = 1ull << (ActionIndex & 63);
+                if (Word & Bit)
+                {
+                    continue;
+                }
+                Word |= Bit;
+                Estimate += Set.Costs[ActionIndex];
+
+                const FPackedState& Preconditions = Set.Preconditions[ActionIndex];
+                ForEachFact(Preconditions.Mask, [&](int32_t Fact)
+                    {
+                        Worklist.push_back(GetLiteral(Preconditions, Fact));
+                    });
+            }
+            return Estimate;
+        }
+
+        /** Literal index of a fact with the value it has in a packed state. */
+        static int32_t GetLiteral(const FPackedState& State, int32_t Fact)
+        {
+            return Fact * 2 + (int32_t)((State.Values[Fact >> 6] >> (Fact & 63)) & 1);
+        }
+
+        struct FLiteralEntry
+        {
+            float Cost;
+            int32_t Literal;
+        };
+
+        /** Min-heap order for the std heap functions, which keep the greatest element on top. */
+        struct FLiteralAfter
+        {
+            bool operator()(const FLiteralEntry& A, const FLiteralEntry& B) const { return B.Cost < A.Cost; }
+        };
+
+        void PushLiteral(const FLiteralEntry& Entry)
+        {
+            Queue.push_back(Entry);
+            std::push_heap(Queue.begin(), Queue.end(), FLiteralAfter());
+        }
+
+        FLiteralEntry PopLiteral()
+        {
+            std::pop_heap(Queue.begin(), Queue.end(), FLiteralAfter());
+            const FLiteralEntry Entry = Queue.back();
+            Queue.pop_back();
+            return Entry;
+        }
+
+        const FActionSet* ActionSet = nullptr;
+        EHeuristic Mode = EHeuristic::GoalCount;
+        bool bRegressive = false;
+
+        /** Relaxed cost per literal, index Fact * 2 + Value like the effect rows of the action set. */
+        float LiteralCosts[GOAP_MAX_FACTS * 2];
+
+        /** Cheapest action reaching each literal, IndexNone for literals that hold from the start. */
+        int32_t Supporters[GOAP_MAX_FACTS * 2];
+
+        /** Whether a literal's cost is final. */
+        bool bSettled[GOAP_MAX_FACTS * 2];
+
+        /** Per action scratch: accumulated precondition cost and preconditions not settled yet. */
+        std::vector<float> PreconditionCosts;
+        std::vector<int32_t> RemainingPreconditions;
+
+        /** Scratch for the cost pass and the relaxed plan extraction. */
+        std::vector<FLiteralEntry> Queue;
+        std::vector<int32_t> Worklist;
+        std::vector<FWord> UsedActions;
+    };
+}
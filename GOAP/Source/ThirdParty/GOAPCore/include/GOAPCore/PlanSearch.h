@@ -0,0 +1,1159 @@
+#pragma once
+
+#include "GOAPCore/Types.h"
+#include "GOAPCore/ActionSet.h"
+#include "GOAPCore/Search.h"
+#include "GOAPCore/Heuristic.h"
+#include "GOAPCore/Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// \file PlanSearch.h
+
+/**
+ * @brief Profiler scope around the search's hot paths, empty by default.
+ *
+ * Define it on the compiler command line to feed a profiler, with GOAPCORE_TRACE_INCLUDE
+ * naming the header it needs. The engine module maps it to an Unreal Insights CPU scope.
+ * Name is a bare identifier. The definition must be the same in every translation unit.
+ */
+#ifdef GOAPCORE_TRACE_INCLUDE
+#include GOAPCORE_TRACE_INCLUDE
+#endif
+
+#ifndef GOAPCORE_TRACE_SCOPE
+#define GOAPCORE_TRACE_SCOPE(Name)
+#endif
+
+namespace GOAPCore
+{
+    /** Direction in which the planner searches, see the engine side EGOAPSearchMode. */
+    enum class ESearchMode : uint8_t
+    {
+        /** Search from the current state, expanding every applicable action. */
+        Forward,
+
+        /** Search back from the goal, only expanding actions whose effects achieve an open subgoal. */
+        Regressive,
+
+        /** Regressive search that keeps its search graph between replans for the same goal. */
+        Incremental
+    };
+
+    /** How much the search logs, same values as the engine side EGOAPDebugLevel. */
+    enum class EDebugLevel : uint8_t
+    {
+        None,
+        /** Logs the outcome of each search. */
+        Minimal,
+        /** Also records every expansion, child and pruned action into the thread's trace buffer, see Trace.h. */
+        Detailed
+    };
+
+    /** State of a resumable search. */
+    enum class ESearchStatus : uint8_t
+    {
+        /** No search was started, or it was cancelled. */
+        Idle,
+        /** The search needs more steps. */
+        InProgress,
+        /** An anytime search has a plan and keeps refining it, see FPlanSearch::StartAnytime. */
+        Improving,
+        /** A plan was found, see FPlanSearch::GetPlan. */
+        Succeeded,
+        /** The open list ran dry, the iteration limit was hit or the search was cancelled. */
+        Failed
+    };
+
+    /** Why a search failed, see FSearchStats::Failure. */
+    enum class ESearchFailure : uint8_t
+    {
+        /** The search has not failed. */
+        None,
+        /** The goal cannot be reached even in the relaxed problem, decided without searching. */
+        Unreachable,
+        /** Every reachable node was expanded without reaching the goal. */
+        Exhausted,
+        /** The iteration limit was hit first. */
+        IterationLimit,
+        /** The search was cancelled. */
+        Cancelled
+    };
+
+    /** Work done by one search, counted from its start. */
+    struct FSearchStats
+    {
+        /** Nodes taken off the open list and expanded. */
+        int32_t NodesExpanded = 0;
+
+        /** Nodes added to the pool, the root included. A reused incremental graph only counts new ones. */
+        int32_t NodesGenerated = 0;
+
+        /** Largest open list, stale entries included since they take memory as well. */
+        int32_t PeakOpen = 0;
+
+        /** Largest number of closed nodes. */
+        int32_t PeakClosed = 0;
+
+        /** Why the search failed, None while it runs and once it succeeded. */
+        ESearchFailure Failure = ESearchFailure::None;
+    };
+
+    /** One goal of a multi-goal search. */
+    struct FGoalCandidate
+    {
+        /** Packed goal state. */
+        FPackedState Goal;
+
+        /** Utility of reaching the goal, before the plan cost is subtracted. */
+        float Priority = 0.f;
+    };
+
+    /** Receives the search's log lines, already formatted. */
+    using FLogSink = void (*)(const char* Message);
+
+    /**
+     * @brief A resumable A* search over compiled actions.
+     *
+     * Keeps its open list, node pool and closed set between calls, so a search can be spread
+     * over several frames by calling @ref Step with a small budget each time. Only touches its
+     * own data and the immutable action set, so it can also run on any thread.
+     *
+     * The action set is referenced, not copied. It must stay alive and unchanged until the
+     * next Start or @ref Reset.
+     */
+    class FPlanSearch
+    {
+    public:
+        /**
+         * @brief Starts a new search, discarding the previous one but keeping its allocations.
+         *
+         * @param InActionSet The compiled actions.
+         * @param InCurrent The current packed world state.
+         * @param InGoal The packed goal state to achieve.
+         * @param InDebugLevel Debug verbosity level for logging planner details.
+         * @param InSearchMode Search forward from the current state or regressively from the goal.
+         * @param InMaxIterations Expansions after which the search gives up.
+         * @param InHeuristic The estimate of the remaining cost that guides the search.
+         */
+        void Start(const FActionSet& InActionSet, const FPackedState& InCurrent, const FPackedState& InGoal,
+            EDebugLevel InDebugLevel, ESearchMode InSearchMode, int32_t InMaxIterations,
+            EHeuristic InHeuristic = EHeuristic::GoalCount);
+
+        /**
+         * @brief Starts a regressive search that reuses the graph of the previous one.
+         *
+         * Regressive nodes are subgoal sets derived from the goal alone, so their costs and
+         * parents stay valid when only the current state changed. Only the heuristic and the
+         * goal test depend on it: the heuristic of nodes mentioning a changed fact is updated,
+         * expanded nodes that the new state satisfies are reopened as goal candidates and the
+         * open list is rebuilt. A relaxed heuristic measures every node from the current state,
+         * so it is updated on every node. Falls back to a fresh search when the goal, the
+         * heuristic or the actions changed, the previous search was not regressive, or the
+         * graph grew too large.
+         *
+         * @param InActionSet The compiled actions.
+         * @param InCurrent The new current packed world state.
+         * @param InGoal The packed goal state to achieve.
+         * @param InDebugLevel Debug verbosity level for logging planner details.
+         * @param InMaxIterations Expansions after which this search gives up.
+         * @param InHeuristic The estimate of the remaining cost that guides the search.
+         * @return True if the previous graph was reused.
+         */
+        bool StartIncremental(const FActionSet& InActionSet, const FPackedState& InCurrent, const FPackedState& InGoal,
+            EDebugLevel InDebugLevel, int32_t InMaxIterations, EHeuristic InHeuristic = EHeuristic::GoalCount);
+
+        /**
+         * @brief Starts a forward search for the best of several goals in one pass.
+         *
+         * Forward nodes do not depend on the goal, so one open list and closed set serve every
+         * candidate. A goal reached with plan cost G is worth Priority - CostWeight * G. Nodes are
+         * expanded in order of the best utility any candidate could still reach through them,
+         * using the heuristic as a lower bound on the remaining cost, and the search ends once no
+         * open node can beat the best goal reached so far. With a zero weight this is the highest
+         * priority reachable goal, at any plan cost.
+         *
+         * @param InActionSet The compiled actions.
+         * @param InCurrent The current packed world state.
+         * @param InGoals The candidate goals.
+         * @param NumGoals Number of candidates.
+         * @param InCostWeight Utility lost per unit of plan cost.
+         * @param InDebugLevel Debug verbosity level for logging planner details.
+         * @param InMaxIterations Expansions after which the search settles for the best goal reached, if any.
+         * @param InHeuristic The estimate of the remaining cost, only an admissible one keeps the choice of goal exact.
+         */
+        void StartMultiGoal(const FActionSet& InActionSet, const FPackedState& InCurrent,
+            const FGoalCandidate* InGoals, int32_t NumGoals, float InCostWeight,
+            EDebugLevel InDebugLevel, int32_t InMaxIterations, EHeuristic InHeuristic = EHeuristic::GoalCount);
+
+        /**
+         * @brief Starts an anytime search that finds a first plan fast and then refines it (ARA*).
+         *
+         * Runs weighted A* with the heuristic inflated by InInitialWeight. Once the best goal
+         * node found cannot be beaten at the current weight, the plan is published and @ref Step
+         * returns Improving. The next steps lower the weight by InWeightStep and continue from
+         * the same graph: nodes whose cost improved after they were expanded are reopened
+         * instead of searched again. The search succeeds once the weight reaches one or the
+         * plan is proven optimal.
+         *
+         * @param InActionSet The compiled actions.
+         * @param InCurrent The current packed world state.
+         * @param InGoal The packed goal state to achieve.
+         * @param InInitialWeight Heuristic inflation of the first search, at least one.
+         * @param InWeightStep How much the weight drops after each published plan.
+         * @param InDebugLevel Debug verbosity level for logging planner details.
+         * @param InSearchMode Search forward from the current state or regressively from the goal.
+         * @param InMaxIterations Expansions after which the search settles for its last plan, if any.
+         * @param InHeuristic The estimate of the remaining cost. The suboptimality bound only holds for an admissible one.
+         */
+        void StartAnytime(const FActionSet& InActionSet, const FPackedState& InCurrent, const FPackedState& InGoal,
+            float InInitialWeight, float InWeightStep, EDebugLevel InDebugLevel, ESearchMode InSearchMode,
+            int32_t InMaxIterations, EHeuristic InHeuristic = EHeuristic::GoalCount);
+
+        /**
+         * @brief Continues the search within a budget.
+         *
+         * At least one node is expanded per call, so a search always makes progress. An anytime
+         * search returns after each plan it publishes.
+         *
+         * @param MaxExpansions Number of nodes to expand at most.
+         * @param MaxMicroseconds Time budget for this call, zero or less for no time limit.
+         * @param bCancelled Optional flag polled every expansion, the search fails once it is set.
+         * @return The status after this step.
+         */
+        ESearchStatus Step(int32_t MaxExpansions, double MaxMicroseconds = 0.0, const std::atomic<bool>* bCancelled = nullptr);
+
+        /** Drops the search and forgets the action set, keeping the allocations. */
+        void Reset();
+
+        /**
+         * @brief Sets where log lines go, nothing is formatted without a sink.
+         *
+         * @param InLogSink Called with each line, or null to stay silent.
+         */
+        void SetLogSink(FLogSink InLogSink) { LogSink = InLogSink; }
+
+        ESearchStatus GetStatus() const { return Status; }
+        bool IsInProgress() const { return Status == ESearchStatus::InProgress || Status == ESearchStatus::Improving; }
+
+        /** @return The plan as indices into the action list, in execution order, once the search succeeded. */
+        const std::vector<int32_t>& GetPlan() const { return Plan; }
+
+        /** @return Number of nodes expanded so far. */
+        int32_t GetNumIterations() const { return Iter; }
+
+        /** @return Number of nodes in the pool, the root included. */
+        int32_t GetNumNodes() const { return Context.NumNodes(); }
+
+        /** @return What the current search did so far and why it failed, if it did. */
+        const FSearchStats& GetStats() const { return Stats; }
+
+        /** @return Id the current search's trace events carry, zero unless it runs at EDebugLevel::Detailed. */
+        uint16_t GetSearchId() const { return SearchId; }
+
+        /** @return The action set of the running search, null after @ref Reset. */
+        const FActionSet* GetActionSet() const { return ActionSet; }
+        const FPackedState& GetCurrent() const { return Current; }
+        const FPackedState& GetGoal() const { return Goal; }
+        ESearchMode GetSearchMode() const { return SearchMode; }
+        EHeuristic GetHeuristic() const { return HeuristicMode; }
+
+        /** @return True if the search was started by @ref StartMultiGoal. */
+        bool IsMultiGoal() const { return bMultiGoal; }
+
+        /** @return Index of the candidate a multi-goal search reached, IndexNone before one is reached. */
+        int32_t GetGoalIndex() const { return GoalIndex; }
+
+        /** @return True if the search was started by @ref StartAnytime. */
+        bool IsAnytime() const { return bAnytime; }
+
+        /** @return Number of plans an anytime search has published, each one at least as cheap as the last. */
+        int32_t GetNumSolutions() const { return NumSolutions; }
+
+        /**
+         * @return Factor by which the last published plan may exceed the optimal cost, one once
+         *         it is proven optimal. Only meaningful for anytime searches with an admissible heuristic.
+         */
+        float GetSuboptimalityBound() const { return SuboptimalityBound; }
+
+    private:
+        /** Sets up @ref HeuristicMode for the search that is starting. */
+        void StartHeuristic(EHeuristic InHeuristic);
+
+        /**
+         * @brief Estimates the remaining cost of a node with the search's heuristic.
+         *
+         * @param NodeState The node's state (forward) or open subgoals (regressive).
+         * @param NodeGoal The goal a forward node is measured against.
+         * @return The estimate, FRelaxedHeuristic::Unreachable if the goal cannot be reached from the node.
+         */
+        float EvaluateHeuristic(const FPackedState& NodeState, const FPackedState& NodeGoal);
+
+        /**
+         * @brief Best utility any candidate goal could still reach through a node.
+         *
+         * @param NodeState The node's state.
+         * @param NodeG The cost of the path to the node.
+         * @param OutMinH Receives the smallest heuristic over the candidates, used to break ties.
+         * @return The bound, or -MaxFloat without candidates.
+         */
+        float GetUtilityBound(const FPackedState& NodeState, float NodeG, float& OutMinH);
+
+        /** Ends a multi-goal search with the best goal reached. */
+        ESearchStatus FinishMultiGoal();
+
+        /**
+         * @brief Publishes the best plan of an anytime search and starts the next, less inflated pass.
+         *
+         * @param bFinal True if the search cannot continue, the plan is published as the final result.
+         * @return The status after publishing.
+         */
+        ESearchStatus PublishAnytimePlan(bool bFinal);
+
+        /** @return Open list key of a node in an anytime search. */
+        float GetAnytimeKey(const FSearchNode& Node) const { return Node.G + Weight * Node.H; }
+
+        /** @return True if a node of this search reaches the goal. */
+        bool IsGoalNode(const FPackedState& NodeState) const
+        {
+            return bRegressive ? Current.Satisfies(NodeState) : NodeState.Satisfies(Goal);
+        }
+
+        /** Ends the search as failed for a reason. */
+        ESearchStatus Fail(ESearchFailure Reason)
+        {
+            Stats.Failure = Reason;
+            Status = ESearchStatus::Failed;
+            return Status;
+        }
+
+        /** @return The failure when the open list runs dry or the iteration limit is reached. */
+        ESearchFailure GetExhaustedReason() const
+        {
+            return Iter >= MaxIterations ? ESearchFailure::IterationLimit : ESearchFailure::Exhausted;
+        }
+
+        /** Starts tracing a search whose root was just added, when the debug level asks for it. */
+        void BeginTrace(int32_t RootIndex);
+
+        /** Records an event of the current search, does nothing unless it is traced. */
+        void RecordEvent(ETraceEvent Type, int32_t Node, int32_t Parent, int32_t Action, FWord Hash, float G, float H,
+            EPruneReason Reason = EPruneReason::None)
+        {
+            if (TraceBuffer)
+            {
+                TraceBuffer->Write(FTraceEvent{ Hash, SearchId, Type, Reason, Node, Parent, Action, G, H });
+            }
+        }
+
+        /** @return True if lines of this level are logged. */
+        bool ShouldLog(EDebugLevel RequiredLevel) const { return LogSink && DebugLevel >= RequiredLevel; }
+
+        /** Formats a line and hands it to the sink. */
+        void Log(const char* Format, ...) const;
+
+        /** Node pool, open list and state table, reused between searches so planning does not allocate. */
+        FSearchContext Context;
+
+        const FActionSet* ActionSet = nullptr;
+        FPackedState Current;
+        FPackedState Goal;
+        EDebugLevel DebugLevel = EDebugLevel::None;
+        ESearchMode SearchMode = ESearchMode::Forward;
+        bool bRegressive = false;
+        FLogSink LogSink = nullptr;
+
+        EHeuristic HeuristicMode = EHeuristic::GoalCount;
+
+        /** Scratch and, for regressive searches, precomputed literal costs of the relaxed heuristics. */
+        FRelaxedHeuristic RelaxedHeuristic;
+
+        /** Whether the context holds a regressive graph for @ref Goal that @ref StartIncremental can reuse. */
+        bool bGraphReusable = false;
+
+        /** Signature of the action set the reusable graph was built with. */
+        FWord GraphSignature = 0;
+
+        /** Multi-goal state, see @ref StartMultiGoal. */
+        bool bMultiGoal = false;
+        std::vector<FGoalCandidate> Goals;
+        float CostWeight = 0.f;
+        int32_t GoalIndex = IndexNone;
+        int32_t BestNodeIndex = IndexNone;
+        float BestUtility = -MaxFloat;
+
+        /** Anytime state, see @ref StartAnytime. BestNodeIndex holds the cheapest goal node found. */
+        bool bAnytime = false;
+        float Weight = 1.f;
+        float WeightStep = 0.f;
+        float SuboptimalityBound = 1.f;
+        int32_t NumSolutions = 0;
+
+        /** Nodes whose cost improved after they were expanded in the current pass. */
+        std::vector<int32_t> Inconsistent;
+
+        int32_t MaxIterations = 0;
+        int32_t Iter = 0;
+        int32_t NumClosed = 0;
+
+        std::vector<int32_t> Plan;
+        ESearchStatus Status = ESearchStatus::Idle;
+
+        FSearchStats Stats;
+
+        /** Buffer of the thread running the search, null unless it is traced. Fetched again every step. */
+        FTraceBuffer* TraceBuffer = nullptr;
+        uint16_t SearchId = 0;
+    };
+
+// Logs through the search's sink, arguments are only evaluated when the line is wanted
+#define GOAPCORE_LOG(RequiredLevel, Format, ...) \
+    if (ShouldLog(RequiredLevel)) \
+    { \
+        Log(Format, ##__VA_ARGS__); \
+    }
+
+    inline void FPlanSearch::Log(const char* Format, ...) const
+    {
+        char Buffer[512];
+        va_list Args;
+        va_start(Args, Format);
+        std::vsnprintf(Buffer, sizeof(Buffer), Format, Args);
+        va_end(Args);
+        LogSink(Buffer);
+    }
+
+    inline void FPlanSearch::Start(const FActionSet& InActionSet, const FPackedState& InCurrent, const FPackedState& InGoal,
+        EDebugLevel InDebugLevel, ESearchMode InSearchMode, int32_t InMaxIterations, EHeuristic InHeuristic)
+    {
+        ActionSet = &InActionSet;
+        Current = InCurrent;
+        Goal = InGoal;
+        DebugLevel = InDebugLevel;
+        SearchMode = InSearchMode;
+        MaxIterations = InMaxIterations;
+        Iter = 0;
+        NumClosed = 0;
+        Stats = FSearchStats();
+        SearchId = 0;
+        Plan.clear();
+        bGraphReusable = false;
+        bMultiGoal = false;
+        Goals.clear();
+        GoalIndex = IndexNone;
+        bAnytime = false;
+        BestNodeIndex = IndexNone;
+        NumSolutions = 0;
+        SuboptimalityBound = 1.f;
+
+        if (Current.Satisfies(Goal))
+        {
+            GOAPCORE_LOG(EDebugLevel::Minimal, "[Planner] Current state already satisfies goal.");
+            Status = ESearchStatus::Succeeded;
+            return;
+        }
+
+        const FActionSet& Set = *ActionSet;
+        FSearchContext& Ctx = Context;
+
+        // Regressive search starts from the goal's desired facts, its nodes are partial states
+        // of open subgoals where facts outside the mask are don't-care
+        bRegressive = SearchMode == ESearchMode::Regressive || SearchMode == ESearchMode::Incremental;
+        const FPackedState& Root = bRegressive ? Goal : Current;
+
+        // Flat node pool with parent links. A cheaper path to a known state updates its node
+        // in place and pushes a new heap entry, the old entry is skipped as stale when popped.
+        // Forward nodes also keep their applicable actions so children only retest actions
+        // that read a fact the parent's action changed.
+        Ctx.Reset(1024, bRegressive ? 0 : Set.NumActionWords, Set.NumActionWords);
+        StartHeuristic(InHeuristic);
+
+        FSearchNode RootNode;
+        RootNode.State = Root;
+        RootNode.Hash = Root.GetHash();
+        RootNode.G = 0.f;
+        RootNode.H = EvaluateHeuristic(Root, Goal);
+
+        // The relaxed problem cannot reach the goal, no need to search
+        if (RootNode.H == FRelaxedHeuristic::Unreachable && SearchMode != ESearchMode::Incremental)
+        {
+            GOAPCORE_LOG(EDebugLevel::Minimal, "[Planner] Goal unreachable even without delete effects, no plan.");
+            Fail(ESearchFailure::Unreachable);
+            return;
+        }
+
+        const int32_t StartIndex = Ctx.AddNode(RootNode);
+        if (!bRegressive)
+        {
+            Set.ComputeApplicable(Root, Ctx.GetActionWords(StartIndex));
+        }
+        Ctx.PushOpen(StartIndex);
+        Stats.NodesGenerated = 1;
+        Stats.PeakOpen = 1;
+        BeginTrace(StartIndex);
+
+        bGraphReusable = bRegressive;
+        GraphSignature = Set.Signature;
+        Status = ESearchStatus::InProgress;
+    }
+
+    inline void FPlanSearch::StartAnytime(const FActionSet& InActionSet, const FPackedState& InCurrent, const FPackedState& InGoal,
+        float InInitialWeight, float InWeightStep, EDebugLevel InDebugLevel, ESearchMode InSearchMode,
+        int32_t InMaxIterations, EHeuristic InHeuristic)
+    {
+        // Same graph as a plain search, a changing current state would invalidate the reopened costs
+        const ESearchMode BaseMode = InSearchMode == ESearchMode::Incremental ? ESearchMode::Regressive : InSearchMode;
+        Start(InActionSet, InCurrent, InGoal, InDebugLevel, BaseMode, InMaxIterations, InHeuristic);
+        bGraphReusable = false;
+
+        bAnytime = true;
+        Weight = std::max(1.f, InInitialWeight);
+        WeightStep = std::max(0.f, InWeightStep);
+        SuboptimalityBound = Weight;
+        Inconsistent.clear();
+
+        if (Status != ESearchStatus::InProgress)
+        {
+            SuboptimalityBound = 1.f;
+            NumSolutions = Status == ESearchStatus::Succeeded ? 1 : 0;
+            return;
+        }
+
+        // The root went in with its plain F, queue it again under the inflated key
+        Context.Open.clear();
+        Context.PushOpen(0, GetAnytimeKey(Context.Nodes[0]));
+    }
+
+    inline ESearchStatus FPlanSearch::PublishAnytimePlan(bool bFinal)
+    {
+        FSearchContext& Ctx = Context;
+        const float BestG = Ctx.Nodes[BestNodeIndex].G;
+        Ctx.BuildPath(BestNodeIndex, Plan, /*bReverse*/ !bRegressive);
+        ++NumSolutions;
+
+        // The optimal cost is at least the smallest unweighted F left to expand
+        float MinF = BestG;
+        for (const FOpenEntry& Entry : Ctx.Open)
+        {
+            const FSearchNode& Node = Ctx.Nodes[Entry.NodeIndex];
+            if (!Node.bClosed && Node.G == Entry.G)
+            {
+                MinF = std::min(MinF, Node.F());
+            }
+        }
+        for (int32_t NodeIndex : Inconsistent)
+        {
+            MinF = std::min(MinF, Ctx.Nodes[NodeIndex].F());
+        }
+        SuboptimalityBound = MinF > 0.f ? std::min(Weight, BestG / MinF) : 1.f;
+
+        GOAPCORE_LOG(EDebugLevel::Minimal,
+            "[Planner] Anytime plan %d with %d steps (G=%.2f, Weight=%.2f, Bound=%.2f, Iter=%d)",
+            NumSolutions, (int32_t)Plan.size(), BestG, Weight, SuboptimalityBound, Iter);
+
+        if (bFinal || Weight <= 1.f || SuboptimalityBound <= 1.f || WeightStep <= 0.f)
+        {
+            if (Weight <= 1.f && !bFinal)
+            {
+                SuboptimalityBound = 1.f;
+            }
+            Status = ESearchStatus::Succeeded;
+            return Status;
+        }
+
+        Weight = std::max(1.f, Weight - WeightStep);
+
+        // Next pass: the open and inconsistent nodes are queued under the new weight and the
+        // closed set starts empty, a node is only expanded again once its cost improves.
+        // bClosed marks the nodes already queued while the queue is rebuilt.
+        std::vector<int32_t>& Queued = Inconsistent;
+        for (const FOpenEntry& Entry : Ctx.Open)
+        {
+            const FSearchNode& Node = Ctx.Nodes[Entry.NodeIndex];
+            if (!Node.bClosed && Node.G == Entry.G)
+            {
+                Queued.push_back(Entry.NodeIndex);
+            }
+        }
+
+        Ctx.Open.clear();
+        for (FSearchNode& Node : Ctx.Nodes)
+        {
+            Node.bClosed = false;
+        }
+        for (int32_t NodeIndex : Queued)
+        {
+            FSearchNode& Node = Ctx.Nodes[NodeIndex];
+            if (!Node.bClosed)
+            {
+                Node.bClosed = true;
+                Ctx.Open.push_back(FOpenEntry{ GetAnytimeKey(Node), Node.H, Node.G, NodeIndex });
+            }
+        }
+        for (int32_t NodeIndex : Queued)
+        {
+            Ctx.Nodes[NodeIndex].bClosed = false;
+        }
+        Ctx.Heapify();
+        Queued.clear();
+        NumClosed = 0;
+
+        Status = ESearchStatus::Improving;
+        return Status;
+    }
+
+    inline void FPlanSearch::StartMultiGoal(const FActionSet& InActionSet, const FPackedState& InCurrent,
+        const FGoalCandidate* InGoals, int32_t NumGoals, float InCostWeight,
+        EDebugLevel InDebugLevel, int32_t InMaxIterations, EHeuristic InHeuristic)
+    {
+        ActionSet = &InActionSet;
+        Current = InCurrent;
+        Goal = FPackedState();
+        DebugLevel = InDebugLevel;
+        SearchMode = ESearchMode::Forward;
+        MaxIterations = InMaxIterations;
+        Iter = 0;
+        NumClosed = 0;
+        Stats = FSearchStats();
+        SearchId = 0;
+        Plan.clear();
+        bGraphReusable = false;
+        bRegressive = false;
+        bAnytime = false;
+
+        bMultiGoal = true;
+        Goals.assign(InGoals, InGoals + NumGoals);
+        CostWeight = std::max(0.f, InCostWeight);
+        GoalIndex = IndexNone;
+        BestNodeIndex = IndexNone;
+        BestUtility = -MaxFloat;
+
+        if (Goals.empty())
+        {
+            Fail(ESearchFailure::Unreachable);
+            return;
+        }
+
+        // Same forward search as Start, only the open list is ordered by utility bound instead of F
+        const FActionSet& Set = *ActionSet;
+        FSearchContext& Ctx = Context;
+        Ctx.Reset(1024, Set.NumActionWords, Set.NumActionWords);
+        StartHeuristic(InHeuristic);
+
+        FSearchNode RootNode;
+        RootNode.State = Current;
+        RootNode.Hash = Current.GetHash();
+        RootNode.G = 0.f;
+        const float RootBound = GetUtilityBound(Current, 0.f, RootNode.H);
+        if (RootBound == -MaxFloat)
+        {
+            GOAPCORE_LOG(EDebugLevel::Minimal, "[Planner] No goal reachable even without delete effects, no plan.");
+            Fail(ESearchFailure::Unreachable);
+            return;
+        }
+
+        const int32_t StartIndex = Ctx.AddNode(RootNode);
+        Set.ComputeApplicable(Current, Ctx.GetActionWords(StartIndex));
+        Ctx.PushOpen(StartIndex, -RootBound);
+        Stats.NodesGenerated = 1;
+        Stats.PeakOpen = 1;
+        BeginTrace(StartIndex);
+
+        Status = ESearchStatus::InProgress;
+    }
+
+    inline void FPlanSearch::StartHeuristic(EHeuristic InHeuristic)
+    {
+        HeuristicMode = InHeuristic;
+        if (HeuristicMode != EHeuristic::GoalCount)
+        {
+            RelaxedHeuristic.Start(*ActionSet, HeuristicMode, Current, bRegressive);
+        }
+    }
+
+    // Forward nodes are states measured against the goal, regressive nodes are open subgoals measured against the current state
+    inline float FPlanSearch::EvaluateHeuristic(const FPackedState& NodeState, const FPackedState& NodeGoal)
+    {
+        if (HeuristicMode == EHeuristic::GoalCount)
+        {
+            return bRegressive
+                ? (float)Current.CountUnsatisfied(NodeState)
+                : (float)NodeState.CountUnsatisfied(NodeGoal);
+        }
+        return RelaxedHeuristic.Evaluate(NodeState, NodeGoal);
+    }
+
+    inline float FPlanSearch::GetUtilityBound(const FPackedState& NodeState, float NodeG, float& OutMinH)
+    {
+        // One relaxed cost pass serves every candidate
+        const bool bRelaxed = HeuristicMode != EHeuristic::GoalCount;
+        if (bRelaxed)
+        {
+            RelaxedHeuristic.ComputeCosts(NodeState);
+        }
+
+        float Bound = -MaxFloat;
+        OutMinH = MaxFloat;
+        for (const FGoalCandidate& Candidate : Goals)
+        {
+            const float H = bRelaxed ? RelaxedHeuristic.Aggregate(Candidate.Goal) : (float)NodeState.CountUnsatisfied(Candidate.Goal);
+            if (H != FRelaxedHeuristic::Unreachable)
+            {
+                Bound = std::max(Bound, Candidate.Priority - CostWeight * (NodeG + H));
+            }
+            OutMinH = std::min(OutMinH, H);
+        }
+        return Bound;
+    }
+
+    inline ESearchStatus FPlanSearch::FinishMultiGoal()
+    {
+        if (GoalIndex == IndexNone)
+        {
+            GOAPCORE_LOG(EDebugLevel::Minimal,
+                "[Planner] No goal reachable after %d iterations (Open=%d, Closed=%d)", Iter, Context.NumOpen(), NumClosed);
+            return Fail(GetExhaustedReason());
+        }
+
+        Context.BuildPath(BestNodeIndex, Plan);
+        Goal = Goals[GoalIndex].Goal;
+
+        GOAPCORE_LOG(EDebugLevel::Minimal,
+            "[Planner] Multi-goal plan found for goal %d of %d with %d steps (G=%.2f, Utility=%.2f, Iter=%d)",
+            GoalIndex, (int32_t)Goals.size(), (int32_t)Plan.size(), Context.Nodes[BestNodeIndex].G, BestUtility, Iter);
+
+        Status = ESearchStatus::Succeeded;
+        return Status;
+    }
+
+    inline bool FPlanSearch::StartIncremental(const FActionSet& InActionSet, const FPackedState& InCurrent, const FPackedState& InGoal,
+        EDebugLevel InDebugLevel, int32_t InMaxIterations, EHeuristic InHeuristic)
+    {
+        // Nodes never leave the pool, start over once replans have grown it well past one search
+        const bool bCanReuse = bGraphReusable
+            && GraphSignature == InActionSet.Signature
+            && Goal == InGoal
+            && HeuristicMode == InHeuristic
+            && Context.NumNodes() <= InMaxIterations * 16;
+
+        if (!bCanReuse)
+        {
+            Start(InActionSet, InCurrent, InGoal, InDebugLevel, ESearchMode::Incremental, InMaxIterations, InHeuristic);
+            return false;
+        }
+
+        // Facts whose value or presence changed, only nodes mentioning one of them change priority
+        FWord Changed[GOAP_FACT_WORDS];
+        for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+        {
+            Changed[W] = (Current.Mask[W] ^ InCurrent.Mask[W]) | (Current.Values[W] ^ InCurrent.Values[W]);
+        }
+
+        ActionSet = &InActionSet;
+        Current = InCurrent;
+        DebugLevel = InDebugLevel;
+        SearchMode = ESearchMode::Incremental;
+        MaxIterations = InMaxIterations;
+        Iter = 0;
+        SearchId = 0;
+        Plan.clear();
+
+        // Stats count this replan only, the reused graph is not new work
+        Stats = FSearchStats();
+
+        if (Current.Satisfies(Goal))
+        {
+            GOAPCORE_LOG(EDebugLevel::Minimal, "[Planner] Current state already satisfies goal.");
+            Status = ESearchStatus::Succeeded;
+            return true;
+        }
+
+        // Relaxed literal costs depend on the whole current state, every node needs a new estimate
+        StartHeuristic(HeuristicMode);
+        const bool bUpdateAll = HeuristicMode != EHeuristic::GoalCount;
+
+        int32_t NumUpdated = 0;
+        int32_t NumReopened = 0;
+        for (FSearchNode& Node : Context.Nodes)
+        {
+            bool bAffected = bUpdateAll;
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                bAffected |= (Node.State.Mask[W] & Changed[W]) != 0;
+            }
+            if (!bAffected)
+            {
+                continue;
+            }
+
+            Node.H = EvaluateHeuristic(Node.State, Goal);
+            ++NumUpdated;
+
+            // An expanded node the current state now satisfies is a finished plan,
+            // back in the open list it competes with the frontier on its cost
+            if (Node.bClosed && Current.Satisfies(Node.State))
+            {
+                Node.bClosed = false;
+                --NumClosed;
+                ++NumReopened;
+            }
+        }
+
+        Context.RebuildOpen();
+
+        GOAPCORE_LOG(EDebugLevel::Minimal,
+            "[Planner] Reusing search graph: %d nodes, %d updated, %d reopened, Open=%d",
+            Context.NumNodes(), NumUpdated, NumReopened, Context.NumOpen());
+
+        Stats.PeakOpen = Context.NumOpen();
+        Stats.PeakClosed = NumClosed;
+        BeginTrace(0);
+        if (Context.NumOpen() == 0)
+        {
+            Fail(ESearchFailure::Exhausted);
+            return true;
+        }
+        Status = ESearchStatus::InProgress;
+        return true;
+    }
+
+    inline void FPlanSearch::Reset()
+    {
+        ActionSet = nullptr;
+        Plan.clear();
+        bGraphReusable = false;
+        bMultiGoal = false;
+        Goals.clear();
+        GoalIndex = IndexNone;
+        bAnytime = false;
+        Inconsistent.clear();
+        Stats = FSearchStats();
+        TraceBuffer = nullptr;
+        SearchId = 0;
+        Status = ESearchStatus::Idle;
+    }
+
+    inline void FPlanSearch::BeginTrace(int32_t RootIndex)
+    {
+        if (DebugLevel < EDebugLevel::Detailed)
+        {
+            TraceBuffer = nullptr;
+            return;
+        }
+
+        FTraceRegistry& Registry = FTraceRegistry::Get();
+        Registry.AddActionNames(*ActionSet);
+        TraceBuffer = &Registry.GetThreadBuffer();
+        SearchId = Registry.NewSearchId();
+
+        const FSearchNode& Root = Context.Nodes[RootIndex];
+        RecordEvent(ETraceEvent::SearchStart, RootIndex, IndexNone, ActionSet->NumActions, ActionSet->Signature, Root.G, Root.H);
+    }
+
+    // Main planning loop, runs until the budget is spent or the search is decided
+    inline ESearchStatus FPlanSearch::Step(int32_t MaxExpansions, double MaxMicroseconds, const std::atomic<bool>* bCancelled)
+    {
+        if (Status != ESearchStatus::InProgress && Status != ESearchStatus::Improving)
+        {
+            return Status;
+        }
+
+        GOAPCORE_TRACE_SCOPE(GOAPSearchStep);
+
+        // Async searches start on one thread and step on another, record into the stepping thread's buffer
+        TraceBuffer = SearchId != 0 ? &FTraceRegistry::Get().GetThreadBuffer() : nullptr;
+
+        using FClock = std::chrono::steady_clock;
+
+        const FActionSet& Set = *ActionSet;
+        FSearchContext& Ctx = Context;
+        std::vector<int32_t>& OutActionIndices = Plan;
+
+        const FClock::time_point StartTime = FClock::now();
+        const FClock::duration Budget = std::chrono::duration_cast<FClock::duration>(std::chrono::duration<double, std::micro>(std::max(0.0, MaxMicroseconds)));
+
+        for (int32_t Expansions = 0; Expansions < MaxExpansions; ++Expansions)
+        {
+            // Out of time for this step, the open list stays as it is for the next one
+            if (MaxMicroseconds > 0.0 && Expansions > 0 && FClock::now() - StartTime >= Budget)
+            {
+                break;
+            }
+
+            if (bCancelled && bCancelled->load(std::memory_order_relaxed))
+            {
+                GOAPCORE_LOG(EDebugLevel::Minimal, "[Planner] Search cancelled after %d iterations", Iter);
+                return Fail(ESearchFailure::Cancelled);
+            }
+
+            // The best goal node cannot be beaten at this weight, hand its plan out
+            if (bAnytime && BestNodeIndex != IndexNone && Ctx.PeekOpen() >= Ctx.Nodes[BestNodeIndex].G)
+            {
+                return PublishAnytimePlan(/*bFinal*/ Ctx.Open.empty() && Inconsistent.empty());
+            }
+
+            const int32_t NodeIndex = Iter < MaxIterations ? Ctx.PopOpen() : IndexNone;
+            if (NodeIndex == IndexNone && bMultiGoal)
+            {
+                return FinishMultiGoal();
+            }
+            if (NodeIndex == IndexNone && bAnytime && BestNodeIndex != IndexNone)
+            {
+                return PublishAnytimePlan(/*bFinal*/ true);
+            }
+            if (NodeIndex == IndexNone)
+            {
+                GOAPCORE_LOG(EDebugLevel::Minimal,
+                    "[Planner] No plan found after %d iterations (Open=%d, Closed=%d)", Iter, Ctx.NumOpen(), NumClosed);
+                return Fail(GetExhaustedReason());
+            }
+
+            GOAPCORE_TRACE_SCOPE(GOAPExpand);
+            ++Iter;
+            ++Stats.NodesExpanded;
+
+            // Copy what we need, adding children may reallocate the pool
+            const FPackedState NodeState = Ctx.Nodes[NodeIndex].State;
+            const FWord NodeHash = Ctx.Nodes[NodeIndex].Hash;
+            const float NodeG = Ctx.Nodes[NodeIndex].G;
+
+            RecordEvent(ETraceEvent::Expand, NodeIndex, Ctx.Nodes[NodeIndex].Parent, Ctx.Nodes[NodeIndex].ActionIndex,
+                NodeHash, NodeG, Ctx.Nodes[NodeIndex].H);
+
+            if (bMultiGoal)
+            {
+                // No open node can beat the best goal reached, it is the answer
+                float MinH;
+                if (GoalIndex != IndexNone && GetUtilityBound(NodeState, NodeG, MinH) <= BestUtility)
+                {
+                    return FinishMultiGoal();
+                }
+
+                // Every candidate this node reaches is a solution, keep searching for a better one
+                for (int32_t CandidateIndex = 0; CandidateIndex < (int32_t)Goals.size(); ++CandidateIndex)
+                {
+                    const FGoalCandidate& Candidate = Goals[CandidateIndex];
+                    const float Utility = Candidate.Priority - CostWeight * NodeG;
+                    if (Utility > BestUtility && NodeState.Satisfies(Candidate.Goal))
+                    {
+                        RecordEvent(ETraceEvent::GoalFound, NodeIndex, IndexNone, CandidateIndex, NodeHash, NodeG, Ctx.Nodes[NodeIndex].H);
+
+                        GoalIndex = CandidateIndex;
+                        BestNodeIndex = NodeIndex;
+                        BestUtility = Utility;
+                    }
+                }
+            }
+            // Goal test, a regressive node is done once the current state meets all its subgoals.
+            // Anytime searches test goal nodes when they are generated.
+            else if (!bAnytime && IsGoalNode(NodeState))
+            {
+                // Walking back from a regressive node already yields execution order
+                Ctx.BuildPath(NodeIndex, OutActionIndices, /*bReverse*/ !bRegressive);
+                RecordEvent(ETraceEvent::GoalFound, NodeIndex, IndexNone, IndexNone, NodeHash, NodeG, Ctx.Nodes[NodeIndex].H);
+
+                GOAPCORE_LOG(EDebugLevel::Minimal,
+                    "[Planner] Plan found with %d steps (G=%.2f, H=%.2f, Iter=%d)",
+                    (int32_t)OutActionIndices.size(), NodeG, Ctx.Nodes[NodeIndex].H, Iter);
+
+                if (ShouldLog(EDebugLevel::Minimal))
+                {
+                    std::string Seq;
+                    for (int32_t ActionIndex : OutActionIndices)
+                    {
+                        Seq += Set.GetActionName(ActionIndex);
+                        Seq += " -> ";
+                    }
+                    Log("[GOAPPlanner] Plan sequence: %s", Seq.c_str());
+                }
+                Status = ESearchStatus::Succeeded;
+                return Status;
+            }
+
+            Ctx.Nodes[NodeIndex].bClosed = true;
+            ++NumClosed;
+            Stats.PeakClosed = std::max(Stats.PeakClosed, NumClosed);
+
+            // Candidate actions: the ones applicable here (forward) or the ones achieving an open subgoal (regressive)
+            FWord* Candidates = Ctx.ScratchActionWords.data();
+            if (bRegressive)
+            {
+                Set.ComputeAchievers(NodeState, Candidates);
+            }
+            else
+            {
+                std::copy_n(Ctx.GetActionWords(NodeIndex), Set.NumActionWords, Candidates);
+            }
+
+            // Expand by candidate actions
+            for (int32_t Word = 0; Word < Set.NumActionWords; ++Word)
+            {
+                FWord Bits = Candidates[Word];
+                while (Bits)
+                {
+                    const int32_t ActionIndex = Word * 64 + CountTrailingZeros(Bits);
+                    Bits &= Bits - 1;
+
+                    const FPackedState& Preconditions = Set.Preconditions[ActionIndex];
+                    const FPackedState& Effects = Set.Effects[ActionIndex];
+
+                    // Build the child state on the stack, a node is only allocated for new states
+                    FPackedState ChildState = NodeState;
+                    FWord ChildHash = NodeHash;
+
+                    if (bRegressive)
+                    {
+                        // Achievers of one subgoal must not undo another
+                        if (Effects.Conflicts(NodeState))
+                        {
+                            RecordEvent(ETraceEvent::Prune, IndexNone, NodeIndex, ActionIndex, 0, NodeG, 0.f, EPruneReason::UndoesSubgoal);
+                            continue;
+                        }
+
+                        // Achieved subgoals are replaced by the action's preconditions
+                        if (!ChildState.RegressHashed(Effects, Preconditions, ChildHash))
+                        {
+                            RecordEvent(ETraceEvent::Prune, IndexNone, NodeIndex, ActionIndex, 0, NodeG, 0.f, EPruneReason::ContradictsSubgoal);
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        // Apply action effects into the child state, the hash follows the changed facts
+                        ChildState.ApplyHashed(Effects, ChildHash);
+                    }
+
+                    const float ChildG = NodeG + Set.Costs[ActionIndex];
+                    const int32_t ExistingIndex = Ctx.FindNode(ChildHash, ChildState);
+
+                    if (ExistingIndex != IndexNone)
+                    {
+                        FSearchNode& Existing = Ctx.Nodes[ExistingIndex];
+
+                        // Anytime passes remember expanded nodes that got cheaper for the next pass
+                        if (bAnytime && ChildG < Existing.G)
+                        {
+                            Existing.G = ChildG;
+                            Existing.Parent = NodeIndex;
+                            Existing.ActionIndex = ActionIndex;
+
+                            RecordEvent(ETraceEvent::Reopen, ExistingIndex, NodeIndex, ActionIndex, ChildHash, ChildG, Existing.H);
+                            if (BestNodeIndex != IndexNone && IsGoalNode(ChildState) && ChildG < Ctx.Nodes[BestNodeIndex].G)
+                            {
+                                BestNodeIndex = ExistingIndex;
+                                RecordEvent(ETraceEvent::GoalFound, ExistingIndex, IndexNone, IndexNone, ChildHash, ChildG, Existing.H);
+                            }
+
+                            if (Existing.bClosed)
+                            {
+                                Inconsistent.push_back(ExistingIndex);
+                            }
+                            else
+                            {
+                                Ctx.PushOpen(ExistingIndex, GetAnytimeKey(Existing));
+                            }
+                            continue;
+                        }
+
+                        // If already visited this resulting state, skip
+                        if (Existing.bClosed)
+                        {
+                            RecordEvent(ETraceEvent::Prune, ExistingIndex, NodeIndex, ActionIndex, ChildHash, ChildG, Existing.H, EPruneReason::Visited);
+                            continue;
+                        }
+
+                        // Only keep the child if it is the cheapest known way to reach its state
+                        if (ChildG >= Existing.G)
+                        {
+                            RecordEvent(ETraceEvent::Prune, ExistingIndex, NodeIndex, ActionIndex, ChildHash, ChildG, Existing.H, EPruneReason::CheaperQueued);
+                            continue;
+                        }
+
+                        Existing.G = ChildG;
+                        Existing.Parent = NodeIndex;
+                        Existing.ActionIndex = ActionIndex;
+
+                        RecordEvent(ETraceEvent::Reopen, ExistingIndex, NodeIndex, ActionIndex, ChildHash, ChildG, Existing.H);
+
+                        if (bMultiGoal)
+                        {
+                            float MinH;
+                            Ctx.PushOpen(ExistingIndex, -GetUtilityBound(ChildState, ChildG, MinH));
+                            continue;
+                        }
+
+                        Ctx.PushOpen(ExistingIndex);
+                        continue;
+                    }
+
+                    FSearchNode Child;
+                    Child.State = ChildState;
+                    Child.Hash = ChildHash;
+                    Child.G = ChildG;
+                    float ChildBound = 0.f;
+                    if (bMultiGoal)
+                    {
+                        // Nothing through this child can beat the goal already reached
+                        ChildBound = GetUtilityBound(ChildState, ChildG, Child.H);
+                        if (ChildBound == -MaxFloat || (GoalIndex != IndexNone && ChildBound <= BestUtility))
+                        {
+                            RecordEvent(ETraceEvent::Prune, IndexNone, NodeIndex, ActionIndex, ChildHash, ChildG, Child.H, EPruneReason::UtilityBound);
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        Child.H = EvaluateHeuristic(ChildState, Goal);
+
+                        // Unreachable even when nothing is ever undone, so unreachable for real. The
+                        // incremental graph keeps the node, a later current state may reach it.
+                        if (Child.H == FRelaxedHeuristic::Unreachable && SearchMode != ESearchMode::Incremental)
+                        {
+                            RecordEvent(ETraceEvent::Prune, IndexNone, NodeIndex, ActionIndex, ChildHash, ChildG, Child.H, EPruneReason::Unreachable);
+                            continue;
+                        }
+                    }
+                    Child.Parent = NodeIndex;
+                    Child.ActionIndex = ActionIndex;
+
+                    // Add to open list, the child inherits the parent's applicable actions
+                    // except for those reading a fact this action changed
+                    const int32_t ChildIndex = Ctx.AddNode(Child);
+                    ++Stats.NodesGenerated;
+                    RecordEvent(ETraceEvent::Generate, ChildIndex, NodeIndex, ActionIndex, ChildHash, ChildG, Child.H);
+                    if (!bRegressive)
+                    {
+                        Set.UpdateApplicable(NodeState, ChildState, Ctx.GetActionWords(NodeIndex), Ctx.GetActionWords(ChildIndex));
+                    }
+                    if (bMultiGoal)
+                    {
+                        Ctx.PushOpen(ChildIndex, -ChildBound);
+                        continue;
+                    }
+                    if (bAnytime)
+                    {
+                        if (IsGoalNode(ChildState) && (BestNodeIndex == IndexNone || ChildG < Ctx.Nodes[BestNodeIndex].G))
+                        {
+                            BestNodeIndex = ChildIndex;
+                            RecordEvent(ETraceEvent::GoalFound, ChildIndex, IndexNone, IndexNone, ChildHash, ChildG, Child.H);
+                        }
+                        Ctx.PushOpen(ChildIndex, GetAnytimeKey(Ctx.Nodes[ChildIndex]));
+                        continue;
+                    }
+                    Ctx.PushOpen(ChildIndex);
+                }
+            }
+
+            Stats.PeakOpen = std::max(Stats.PeakOpen, Ctx.NumOpen());
+        }
+
+        return Status;
+    }
+
+#undef GOAPCORE_LOG
+}
@@ -0,0 +1,407 @@
+#pragma once
+
+#include "GOAPCore/Types.h"
+#include <algorithm>
+#include <vector>
+
+/// \file Search.h
+
+namespace GOAPCore
+{
+    /**
+     * @brief One node of a planner search, stored in a contiguous pool.
+     *
+     * Nodes never own a path. They point back to the node they were generated from and
+     * record the action that produced them, the plan is rebuilt by walking the parents.
+     */
+    struct FSearchNode
+    {
+        /** The state reached at this node. */
+        FPackedState State;
+
+        /** Zobrist hash of @ref State. */
+        FWord Hash = 0;
+
+        /** Cost of the best known path to this node. */
+        float G = 0.f;
+
+        /** Heuristic estimate of the remaining cost. */
+        float H = 0.f;
+
+        /** Pool index of the parent node, IndexNone for the root. */
+        int32_t Parent = IndexNone;
+
+        /** Index of the action that produced this node, IndexNone for the root. */
+        int32_t ActionIndex = IndexNone;
+
+        /** Whether this node has been expanded. */
+        bool bClosed = false;
+
+        float F() const { return G + H; }
+    };
+
+    /**
+     * @brief Entry of the open list heap.
+     *
+     * Only a few words, the node itself stays in the pool. A cheaper path to a node pushes a
+     * new entry instead of a decrease-key, entries whose G no longer matches the node are stale.
+     */
+    struct FOpenEntry
+    {
+        float F = 0.f;
+        float H = 0.f;
+        float G = 0.f;
+        int32_t NodeIndex = IndexNone;
+    };
+
+    /**
+     * @brief Open list ordering: lowest F on top of the heap, ties go to the node closest to the goal.
+     *
+     * The std heap functions keep the greatest element on top, so this answers "A comes after B".
+     */
+    struct FOpenEntryAfter
+    {
+        inline bool operator()(const FOpenEntry& A, const FOpenEntry& B) const
+        {
+            return B.F < A.F || (B.F == A.F && B.H < A.H);
+        }
+    };
+
+    /**
+     * @brief Open-addressing hash table from state hash to node pool index.
+     *
+     * Lookups probe linearly from the Zobrist hash. On a hash match the caller's predicate
+     * compares the full state, so colliding hashes never merge two different states.
+     */
+    struct FStateTable
+    {
+        /**
+         * @brief Clears the table, keeping room for at least ExpectedNum states.
+         *
+         * The table never shrinks, a table that grew during an earlier search keeps its size.
+         *
+         * @param ExpectedNum Number of states the caller expects to insert.
+         */
+        void Reset(int32_t ExpectedNum)
+        {
+            size_t Capacity = 16;
+            while (Capacity < (size_t)ExpectedNum * 2)
+            {
+                Capacity *= 2;
+            }
+            if (Slots.size() < Capacity)
+            {
+                Slots.resize(Capacity);
+            }
+            for (FSlot& Slot : Slots)
+            {
+                Slot.NodeIndex = IndexNone;
+            }
+            NumOccupied = 0;
+        }
+
+        /**
+         * @brief Looks up a node by state.
+         *
+         * @param Hash The Zobrist hash of the state.
+         * @param IsSameState Predicate taking a node index, true if that node holds the state.
+         * @return The node index, or IndexNone if the state is not in the table.
+         */
+        template <typename PredicateType>
+        int32_t Find(FWord Hash, PredicateType&& IsSameState) const
+        {
+            if (Slots.empty())
+            {
+                return IndexNone;
+            }
+
+            const uint32_t IndexMask = (uint32_t)Slots.size() - 1;
+            for (uint32_t Index = (uint32_t)Hash & IndexMask; ; Index = (Index + 1) & IndexMask)
+            {
+                const FSlot& Slot = Slots[Index];
+                if (Slot.NodeIndex == IndexNone)
+                {
+                    return IndexNone;
+                }
+                if (Slot.Hash == Hash && IsSameState(Slot.NodeIndex))
+                {
+                    return Slot.NodeIndex;
+                }
+            }
+        }
+
+        /**
+         * @brief Adds a node for a state that is known not to be in the table yet.
+         *
+         * @param Hash The Zobrist hash of the state.
+         * @param NodeIndex The pool index of the node holding the state.
+         */
+        void Add(FWord Hash, int32_t NodeIndex)
+        {
+            // Keep the load factor at or below one half so probe chains stay short
+            if ((size_t)(NumOccupied + 1) * 2 > Slots.size())
+            {
+                Grow();
+            }
+
+            Insert(Hash, NodeIndex);
+            ++NumOccupied;
+        }
+
+        /** @return The number of states in the table. */
+        int32_t Num() const { return NumOccupied; }
+
+    private:
+        struct FSlot
+        {
+            FWord Hash;
+            int32_t NodeIndex;
+        };
+
+        void Insert(FWord Hash, int32_t NodeIndex)
+        {
+            const uint32_t IndexMask = (uint32_t)Slots.size() - 1;
+            uint32_t Index = (uint32_t)Hash & IndexMask;
+            while (Slots[Index].NodeIndex != IndexNone)
+            {
+                Index = (Index + 1) & IndexMask;
+            }
+            Slots[Index].Hash = Hash;
+            Slots[Index].NodeIndex = NodeIndex;
+        }
+
+        /** Doubles the capacity and reinserts every slot. */
+        void Grow()
+        {
+            std::vector<FSlot> Old = std::move(Slots);
+            Slots.resize(std::max<size_t>(16, Old.size() * 2));
+            for (FSlot& Slot : Slots)
+            {
+                Slot.NodeIndex = IndexNone;
+            }
+
+            for (const FSlot& Slot : Old)
+            {
+                if (Slot.NodeIndex != IndexNone)
+                {
+                    Insert(Slot.Hash, Slot.NodeIndex);
+                }
+            }
+        }
+
+        std::vector<FSlot> Slots;
+        int32_t NumOccupied = 0;
+    };
+
+    /**
+     * @brief Reusable storage for one planner search.
+     *
+     * Holds the node pool, the open list and the state table. Resetting keeps the allocations,
+     * so once a context has warmed up, searches of a similar size never allocate.
+     */
+    struct FSearchContext
+    {
+        /** Contiguous node pool, addressed by 32-bit indices. */
+        std::vector<FSearchNode> Nodes;
+
+        /** Binary heap of open entries. */
+        std::vector<FOpenEntry> Open;
+
+        /** State to node lookup, also acts as the closed set through FSearchNode::bClosed. */
+        FStateTable States;
+
+        /** Per node bitset of applicable actions, NumActionWords words per node in pool order. */
+        std::vector<FWord> NodeActionWords;
+
+        /** Scratch bitset of NumActionWords words used while expanding a node. */
+        std::vector<FWord> ScratchActionWords;
+
+        /** Words per node in @ref NodeActionWords, zero when the search does not track applicable actions. */
+        int32_t NumActionWords = 0;
+
+        /**
+         * @brief Clears the context for a new search.
+         *
+         * @param ExpectedNodes Number of nodes to keep room for.
+         * @param InNumActionWords Words of applicable-action bitset to keep per node, or zero.
+         * @param NumScratchWords Words of scratch bitset needed while expanding.
+         */
+        void Reset(int32_t ExpectedNodes, int32_t InNumActionWords = 0, int32_t NumScratchWords = 0)
+        {
+            NumActionWords = InNumActionWords;
+            Nodes.clear();
+            Nodes.reserve(ExpectedNodes);
+            Open.clear();
+            Open.reserve(ExpectedNodes);
+            States.Reset(ExpectedNodes);
+            NodeActionWords.clear();
+            NodeActionWords.reserve((size_t)ExpectedNodes * NumActionWords);
+            ScratchActionWords.resize(NumScratchWords);
+        }
+
+        /** @return Number of nodes in the pool. */
+        int32_t NumNodes() const { return (int32_t)Nodes.size(); }
+
+        /** @return Number of entries in the open list, stale ones included. */
+        int32_t NumOpen() const { return (int32_t)Open.size(); }
+
+        /**
+         * @brief Returns the applicable-action bitset of a node.
+         *
+         * Only valid while no node is added, adding a node may move the storage.
+         *
+         * @param NodeIndex The node.
+         * @return Pointer to NumActionWords words.
+         */
+        FWord* GetActionWords(int32_t NodeIndex)
+        {
+            return NodeActionWords.data() + (size_t)NodeIndex * NumActionWords;
+        }
+
+        /**
+         * @brief Finds the node holding a state.
+         *
+         * @param Hash The Zobrist hash of the state.
+         * @param State The state to look up.
+         * @return The node index, or IndexNone.
+         */
+        int32_t FindNode(FWord Hash, const FPackedState& State) const
+        {
+            return States.Find(Hash, [this, &State](int32_t NodeIndex) { return Nodes[NodeIndex].State == State; });
+        }
+
+        /**
+         * @brief Appends a node to the pool and registers its state.
+         *
+         * @param Node The node to add.
+         * @return The pool index of the new node.
+         */
+        int32_t AddNode(const FSearchNode& Node)
+        {
+            const int32_t NodeIndex = (int32_t)Nodes.size();
+            Nodes.push_back(Node);
+            States.Add(Node.Hash, NodeIndex);
+            NodeActionWords.resize(NodeActionWords.size() + NumActionWords);
+            return NodeIndex;
+        }
+
+        /**
+         * @brief Pushes an open entry for a node using its current costs.
+         *
+         * @param NodeIndex The node to queue.
+         */
+        void PushOpen(int32_t NodeIndex)
+        {
+            const FSearchNode& Node = Nodes[NodeIndex];
+            PushEntry(FOpenEntry{ Node.F(), Node.H, Node.G, NodeIndex });
+        }
+
+        /**
+         * @brief Pushes an open entry ordered by a caller-provided key instead of the node's F.
+         *
+         * @param NodeIndex The node to queue.
+         * @param Key Sort key, the lowest key is popped first.
+         */
+        void PushOpen(int32_t NodeIndex, float Key)
+        {
+            const FSearchNode& Node = Nodes[NodeIndex];
+            PushEntry(FOpenEntry{ Key, Node.H, Node.G, NodeIndex });
+        }
+
+        /**
+         * @brief Rebuilds the open list from every node that is not closed, using their current costs.
+         *
+         * Used after the heuristic of existing nodes changed, a heapify is cheaper than fixing entries one by one.
+         */
+        void RebuildOpen()
+        {
+            Open.clear();
+            for (int32_t NodeIndex = 0; NodeIndex < NumNodes(); ++NodeIndex)
+            {
+                const FSearchNode& Node = Nodes[NodeIndex];
+                if (!Node.bClosed)
+                {
+                    Open.push_back(FOpenEntry{ Node.F(), Node.H, Node.G, NodeIndex });
+                }
+            }
+            Heapify();
+        }
+
+        /** Restores the heap order after entries were appended to @ref Open directly. */
+        void Heapify()
+        {
+            std::make_heap(Open.begin(), Open.end(), FOpenEntryAfter());
+        }
+
+        /**
+         * @brief Returns the key of the best open node without popping it, dropping stale entries on top.
+         *
+         * @return The key, or MaxFloat if the open list is empty.
+         */
+        float PeekOpen()
+        {
+            while (!Open.empty())
+            {
+                const FOpenEntry& Top = Open.front();
+                const FSearchNode& Node = Nodes[Top.NodeIndex];
+                if (!Node.bClosed && Node.G == Top.G)
+                {
+                    return Top.F;
+                }
+                std::pop_heap(Open.begin(), Open.end(), FOpenEntryAfter());
+                Open.pop_back();
+            }
+            return MaxFloat;
+        }
+
+        /**
+         * @brief Pops the best open node, skipping stale entries.
+         *
+         * @return The node index, or IndexNone if the open list is empty.
+         */
+        int32_t PopOpen()
+        {
+            while (!Open.empty())
+            {
+                std::pop_heap(Open.begin(), Open.end(), FOpenEntryAfter());
+                const FOpenEntry Entry = Open.back();
+                Open.pop_back();
+
+                const FSearchNode& Node = Nodes[Entry.NodeIndex];
+                if (!Node.bClosed && Node.G == Entry.G)
+                {
+                    return Entry.NodeIndex;
+                }
+            }
+            return IndexNone;
+        }
+
+        /**
+         * @brief Collects the actions on the path from the root to a node.
+         *
+         * @param NodeIndex The last node of the path.
+         * @param OutActionIndices Receives the action indices.
+         * @param bReverse True to return them root first (forward search), false to return them
+         *        in the order they were walked, which is execution order for a regressive search.
+         */
+        void BuildPath(int32_t NodeIndex, std::vector<int32_t>& OutActionIndices, bool bReverse = true) const
+        {
+            OutActionIndices.clear();
+            for (int32_t Index = NodeIndex; Index != IndexNone && Nodes[Index].ActionIndex != IndexNone; Index = Nodes[Index].Parent)
+            {
+                OutActionIndices.push_back(Nodes[Index].ActionIndex);
+            }
+            if (bReverse)
+            {
+                std::reverse(OutActionIndices.begin(), OutActionIndices.end());
+            }
+        }
+
+    private:
+        void PushEntry(const FOpenEntry& Entry)
+        {
+            Open.push_back(Entry);
+            std::push_heap(Open.begin(), Open.end(), FOpenEntryAfter());
+        }
+    };
+}
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "GOAPCore/Types.h"
+#include "GOAPCore/ActionSet.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// \file Trace.h
+
+namespace GOAPCore
+{
+    /** Kind of a recorded planner event. */
+    enum class ETraceEvent : uint8_t
+    {
+        /** A search started. Node is the root, Hash the action set signature, Action the number of actions. */
+        SearchStart,
+        /** A node was taken off the open list. Parent and Action are the edge it was reached by. */
+        Expand,
+        /** A new node was added as child of Parent via Action. */
+        Generate,
+        /** A cheaper path to a known node was found, Parent, Action and G are its new edge and cost. */
+        Reopen,
+        /** Action was not expanded from Parent, see Reason. Node is the known node it led to, if any. */
+        Prune,
+        /** Node reaches the goal. Action is the reached candidate of a multi-goal search, IndexNone otherwise. */
+        GoalFound
+    };
+
+    /** Why a Prune event dropped a child. */
+    enum class EPruneReason : uint8_t
+    {
+        None,
+        /** Regressive: the action undoes an open subgoal. */
+        UndoesSubgoal,
+        /** Regressive: the action's preconditions contradict an open subgoal. */
+        ContradictsSubgoal,
+        /** The child's state was already expanded. */
+        Visited,
+        /** A path at least as cheap to the child's state is already queued. */
+        CheaperQueued,
+        /** The goal is unreachable from the child even without delete effects. */
+        Unreachable,
+        /** Multi-goal: no candidate reached through the child can beat the best goal found. */
+        UtilityBound
+    };
+
+    /**
+     * @brief One fixed-size planner event, see ETraceEvent for what the fields hold per kind.
+     *
+     * Node indices are the search's node pool indices, they identify a node within one search.
+     */
+    struct FTraceEvent
+    {
+        FWord Hash;
+        uint16_t SearchId;
+        ETraceEvent Type;
+        EPruneReason Reason;
+        int32_t Node;
+        int32_t Parent;
+        int32_t Action;
+        float G;
+        float H;
+    };
+    static_assert(sizeof(FTraceEvent) == 32, "FTraceEvent should stay two to a cache line");
+
+    /**
+     * @brief Ring buffer of the most recent events of one thread.
+     *
+     * The storage is allocated once, writing an event is a copy and a counter increment and
+     * overwrites the oldest event when the buffer is full. Only the owning thread writes,
+     * any thread may take a snapshot.
+     */
+    class FTraceBuffer
+    {
+    public:
+        /** Number of events kept, a power of two. */
+        static constexpr uint64_t Capacity = 1ull << 15;
+
+        FTraceBuffer() : Events(new FTraceEvent[Capacity]) {}
+
+        void Write(const FTraceEvent& Event)
+        {
+            const uint64_t Index = Head.load(std::memory_order_relaxed);
+            Events[Index & (Capacity - 1)] = Event;
+            Head.store(Index + 1, std::memory_order_release);
+        }
+
+        /** @return Number of events written since the buffer was created, lost ones included. */
+        uint64_t GetNumWritten() const { return Head.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Appends the buffered events, oldest first.
+         *
+         * Events the owner overwrote while they were copied are dropped again, so a snapshot
+         * taken while the owner keeps searching only loses the oldest events.
+         *
+         * @param Out Receives the events.
+         */
+        void Snapshot(std::vector<FTraceEvent>& Out) const
+        {
+            const uint64_t End = Head.load(std::memory_order_acquire);
+            const uint64_t Begin = End > Capacity ? End - Capacity : 0;
+            const size_t Offset = Out.size();
+            for (uint64_t Index = Begin; Index < End; ++Index)
+            {
+                Out.push_back(Events[Index & (Capacity - 1)]);
+            }
+
+            // The owner may be writing the slot after its head, which holds event Head - Capacity
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t NewEnd = Head.load(std::memory_order_relaxed) + 1;
+            const uint64_t FirstIntact = NewEnd > Capacity ? NewEnd - Capacity : 0;
+            if (FirstIntact > Begin)
+            {
+                const size_t NumLost = (size_t)std::min(FirstIntact - Begin, End - Begin);
+                Out.erase(Out.begin() + Offset, Out.begin() + Offset + NumLost);
+            }
+        }
+
+    private:
+        std::unique_ptr<FTraceEvent[]> Events;
+        std::atomic<uint64_t> Head{ 0 };
+    };
+
+    /** Everything a dump holds: events and the action names of the searches that recorded them. */
+    struct FTraceData
+    {
+        std::vector<FTraceEvent> Events;
+
+        /** Action names per action set signature, see ETraceEvent::SearchStart. */
+        std::unordered_map<FWord, std::vector<std::string>> ActionNames;
+    };
+
+    /**
+     * @brief Process-wide owner of the per-thread trace buffers.
+     *
+     * A thread gets its buffer on its first traced search. The buffer stays registered after
+     * the thread exits so a dump still sees its events, and is handed to the next new thread.
+     */
+    class FTraceRegistry
+    {
+    public:
+        static FTraceRegistry& Get()
+        {
+            static FTraceRegistry Registry;
+            return Registry;
+        }
+
+        /** @return The calling thread's buffer. */
+        FTraceBuffer& GetThreadBuffer()
+        {
+            struct FThreadSlot
+            {
+                FTraceBuffer* Buffer = nullptr;
+                ~FThreadSlot()
+                {
+                    if (Buffer)
+                    {
+                        FTraceRegistry::Get().Release(Buffer);
+                    }
+                }
+            };
+            thread_local FThreadSlot Slot;
+            if (!Slot.Buffer)
+            {
+                Slot.Buffer = Acquire();
+            }
+            return *Slot.Buffer;
+        }
+
+        /** @return A non-zero id for a new search, ids wrap after 65535 searches. */
+        uint16_t NewSearchId()
+        {
+            uint16_t Id;
+            do
+            {
+                Id = (uint16_t)NextSearchId.fetch_add(1, std::memory_order_relaxed);
+            } while (Id == 0);
+            return Id;
+        }
+
+        /** Remembers the action names of a set so dumps can name its actions, once per signature. */
+        void AddActionNames(const FActionSet& Set)
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            if (ActionNames.find(Set.Signature) == ActionNames.end())
+            {
+                ActionNames.emplace(Set.Signature, Set.ActionNames);
+            }
+        }
+
+        /**
+         * @brief Copies the events of every thread and the known action names.
+         *
+         * @param Out Receives the events, grouped by thread and oldest first within a thread.
+         */
+        void Capture(FTraceData& Out)
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            for (const std::unique_ptr<FTraceBuffer>& Buffer : Buffers)
+            {
+                Buffer->Snapshot(Out.Events);
+            }
+            Out.ActionNames.insert(ActionNames.begin(), ActionNames.end());
+        }
+
+    private:
+        FTraceBuffer* Acquire()
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            if (!FreeBuffers.empty())
+            {
+                FTraceBuffer* Buffer = FreeBuffers.back();
+                FreeBuffers.pop_back();
+                return Buffer;
+            }
+            Buffers.push_back(std::make_unique<FTraceBuffer>());
+            return Buffers.back().get();
+        }
+
+        void Release(FTraceBuffer* Buffer)
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            FreeBuffers.push_back(Buffer);
+        }
+
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<FTraceBuffer>> Buffers;
+        std::vector<FTraceBuffer*> FreeBuffers;
+        std::unordered_map<FWord, std::vector<std::string>> ActionNames;
+        std::atomic<uint32_t> NextSearchId{ 1 };
+    };
+
+    /** Layout of a trace file: this header, the name tables, then the raw events. */
+    struct FTraceFileHeader
+    {
+        char Magic[8] = { 'G', 'O', 'A', 'P', 'T', 'R', 'C', 'E' };
+        uint32_t Version = 1;
+        uint32_t EventSize = sizeof(FTraceEvent);
+        uint64_t NumEvents = 0;
+        uint64_t NumNameTables = 0;
+    };
+
+    /**
+     * @brief Writes a dump to a binary trace file in host byte order.
+     *
+     * Each name table is its signature, its name count and then every name as a length and
+     * its characters.
+     *
+     * @return False if the file could not be written.
+     */
+    inline bool WriteTraceFile(const char* Path, const FTraceData& Data)
+    {
+        std::FILE* File = std::fopen(Path, "wb");
+        if (!File)
+        {
+            return false;
+        }
+
+        FTraceFileHeader Header;
+        Header.NumEvents = Data.Events.size();
+        Header.NumNameTables = Data.ActionNames.size();
+        bool bOk = std::fwrite(&Header, sizeof(Header), 1, File) == 1;
+
+        for (const auto& Table : Data.ActionNames)
+        {
+            const uint32_t NumNames = (uint32_t)Table.second.size();
+            bOk &= std::fwrite(&Table.first, sizeof(FWord), 1, File) == 1;
+            bOk &= std::fwrite(&NumNames, sizeof(NumNames), 1, File) == 1;
+            for (const std::string& Name : Table.second)
+            {
+                const uint32_t Length = (uint32_t)Name.size();
+                bOk &= std::fwrite(&Length, sizeof(Length), 1, File) == 1;
+                bOk &= std::fwrite(Name.data(), 1, Length, File) == Length;
+            }
+        }
+
+        if (!Data.Events.empty())
+        {
+            bOk &= std::fwrite(Data.Events.data(), sizeof(FTraceEvent), Data.Events.size(), File) == Data.Events.size();
+        }
+        bOk &= std::fclose(File) == 0;
+        return bOk;
+    }
+
+    /**
+     * @brief Reads a file written by @ref WriteTraceFile.
+     *
+     * @return False if the file is missing, truncated or of another version.
+     */
+    inline bool ReadTraceFile(const char* Path, FTraceData& Out)
+    {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> File(std::fopen(Path, "rb"), &std::fclose);
+        if (!File)
+        {
+            return false;
+        }
+
+        FTraceFileHeader Header;
+        const FTraceFileHeader Expected;
+        if (std::fread(&Header, sizeof(Header), 1, File.get()) != 1
+            || std::char_traits<char>::compare(Header.Magic, Expected.Magic, sizeof(Header.Magic)) != 0
+            || Header.Version != Expected.Version
+            || Header.EventSize != Expected.EventSize)
+        {
+            return false;
+        }
+
+        for (uint64_t TableIndex = 0; TableIndex < Header.NumNameTables; ++TableIndex)
+        {
+            FWord Signature;
+            uint32_t NumNames;
+            if (std::fread(&Signature, sizeof(Signature), 1, File.get()) != 1
+                || std::fread(&NumNames, sizeof(NumNames), 1, File.get()) != 1)
+            {
+                return false;
+            }
+
+            std::vector<std::string>& Names = Out.ActionNames[Signature];
+            Names.resize(NumNames);
+            for (std::string& Name : Names)
+            {
+                uint32_t Length;
+                if (std::fread(&Length, sizeof(Length), 1, File.get()) != 1)
+                {
+                    return false;
+                }
+                Name.resize(Length);
+                if (Length && std::fread(&Name[0], 1, Length, File.get()) != Length)
+                {
+                    return false;
+                }
+            }
+        }
+
+        const size_t Offset = Out.Events.size();
+        Out.Events.resize(Offset + (size_t)Header.NumEvents);
+        return std::fread(Out.Events.data() + Offset, sizeof(FTraceEvent), (size_t)Header.NumEvents, File.get()) == Header.NumEvents;
+    }
+}
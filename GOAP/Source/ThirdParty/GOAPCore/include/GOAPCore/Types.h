@@ -0,0 +1,420 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// \file Types.h
+
+/**
+ * @brief Maximum number of distinct facts the GOAP system can track.
+ *
+ * Every fact name is interned into a dense index below this limit so world states can be
+ * stored as fixed-width bitsets. Override it from a project Build.cs through PublicDefinitions
+ * (or with -DGOAP_MAX_FACTS=N in a plain build) if a domain needs more facts.
+ */
+#ifndef GOAP_MAX_FACTS
+#define GOAP_MAX_FACTS 128
+#endif
+
+/** Number of 64-bit words needed to hold one bit per fact. */
+static constexpr int32_t GOAP_FACT_WORDS = (GOAP_MAX_FACTS + 63) / 64;
+
+/**
+ * @brief Engine independent planning core.
+ *
+ * Packed states, compiled action sets and the search itself, in plain C++17 so they can be
+ * built and benchmarked without the engine. The GOAP module wraps these types for UObjects.
+ */
+namespace GOAPCore
+{
+    /**
+     * @brief One word of a fact or action bitset.
+     *
+     * unsigned long long rather than uint64_t so that it is the same type as the engine's
+     * uint64 on every platform, word pointers are passed between the two.
+     */
+    using FWord = unsigned long long;
+
+    /** Index used for "no node" and "no action", same value as the engine's INDEX_NONE. */
+    static constexpr int32_t IndexNone = -1;
+
+    /** Largest finite float, used for unreachable costs and empty bounds. */
+    static constexpr float MaxFloat = std::numeric_limits<float>::max();
+
+    /** @return Index of the lowest set bit, Bits must not be zero. */
+    inline int32_t CountTrailingZeros(FWord Bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long Index;
+        _BitScanForward64(&Index, Bits);
+        return (int32_t)Index;
+#else
+        return __builtin_ctzll(Bits);
+#endif
+    }
+
+    /** @return Number of set bits. */
+    inline int32_t CountBits(FWord Bits)
+    {
+#if defined(_MSC_VER)
+        return (int32_t)__popcnt64(Bits);
+#else
+        return __builtin_popcountll(Bits);
+#endif
+    }
+
+    /**
+     * @brief Calls Visit(FactIndex) for every bit set in a fact mask.
+     *
+     * @param Words GOAP_FACT_WORDS words of fact bits.
+     * @param Visit Callable taking the fact index.
+     */
+    template <typename VisitorType>
+    inline void ForEachFact(const FWord* Words, VisitorType&& Visit)
+    {
+        for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+        {
+            FWord Bits = Words[W];
+            while (Bits)
+            {
+                const int32_t Bit = CountTrailingZeros(Bits);
+                Bits &= Bits - 1;
+                Visit(W * 64 + Bit);
+            }
+        }
+    }
+
+    /**
+     * @brief Zobrist keys for every (fact, value) pair.
+     *
+     * A state hash is the XOR of the keys of all its known facts, so changing a fact only
+     * needs two XORs. The table is filled from a fixed seed and is identical across runs.
+     */
+    struct FZobristTable
+    {
+        /** One key for the false value and one for the true value of each fact. */
+        FWord Keys[GOAP_MAX_FACTS][2];
+    };
+
+    // SplitMix64, good enough to spread the keys and fully deterministic. Evaluated at compile time
+    // so the table is ready before any static initializer could hash a state.
+    constexpr FZobristTable MakeZobristTable()
+    {
+        FZobristTable Table = {};
+        FWord Seed = 0x9E3779B97F4A7C15ull;
+        for (int32_t Fact = 0; Fact < GOAP_MAX_FACTS; ++Fact)
+        {
+            for (int32_t Value = 0; Value < 2; ++Value)
+            {
+                Seed += 0x9E3779B97F4A7C15ull;
+                FWord Z = Seed;
+                Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+                Table.Keys[Fact][Value] = Z ^ (Z >> 31);
+            }
+        }
+        return Table;
+    }
+
+    inline constexpr FZobristTable GZobrist = MakeZobristTable();
+
+    /**
+     * @brief Bit-packed world state used by the planner.
+     *
+     * Each registered fact owns one bit in @ref Values and one bit in @ref Mask.
+     * A fact is known when its mask bit is set, and its value bit then holds true or false.
+     * Value bits outside the mask are always kept at zero, so comparing and merging states
+     * only takes a few AND/OR/XOR operations per 64 facts.
+     */
+    struct FPackedState
+    {
+        /** The value of each known fact. */
+        FWord Values[GOAP_FACT_WORDS] = {};
+
+        /** Which facts are known (or cared about, for preconditions, effects and goals). */
+        FWord Mask[GOAP_FACT_WORDS] = {};
+
+        /**
+         * @brief Checks if this state satisfies a desired state.
+         *
+         * @param Desired The facts that must be known and match in this state.
+         * @return True if every fact in the desired mask is known here with the same value.
+         */
+        inline bool Satisfies(const FPackedState& Desired) const
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                if (((Values[W] ^ Desired.Values[W]) | ~Mask[W]) & Desired.Mask[W])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Overwrites the facts in the effect mask with the effect values.
+         *
+         * @param Effects The facts to apply to this state.
+         */
+        inline void Apply(const FPackedState& Effects)
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                Values[W] = (Values[W] & ~Effects.Mask[W]) | Effects.Values[W];
+                Mask[W] |= Effects.Mask[W];
+            }
+        }
+
+        /**
+         * @brief Counts the desired facts that are missing or different in this state.
+         *
+         * @param Desired The facts to compare against.
+         * @return Number of unsatisfied facts.
+         */
+        inline int32_t CountUnsatisfied(const FPackedState& Desired) const
+        {
+            int32_t Count = 0;
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                Count += CountBits(((Values[W] ^ Desired.Values[W]) | ~Mask[W]) & Desired.Mask[W]);
+            }
+            return Count;
+        }
+
+        /**
+         * @brief Sets a single fact.
+         *
+         * @param Index The registered fact index.
+         * @param bValue The new value of the fact.
+         */
+        inline void SetFact(int32_t Index, bool bValue)
+        {
+            const FWord Bit = 1ull << (Index & 63);
+            Mask[Index >> 6] |= Bit;
+            Values[Index >> 6] = bValue ? (Values[Index >> 6] | Bit) : (Values[Index >> 6] & ~Bit);
+        }
+
+        /**
+         * @brief Reads a single fact.
+         *
+         * @param Index The registered fact index.
+         * @param bOutValue Receives the fact value if it is known.
+         * @return True if the fact is known in this state.
+         */
+        inline bool GetFact(int32_t Index, bool& bOutValue) const
+        {
+            const FWord Bit = 1ull << (Index & 63);
+            bOutValue = (Values[Index >> 6] & Bit) != 0;
+            return (Mask[Index >> 6] & Bit) != 0;
+        }
+
+        /**
+         * @brief Computes the Zobrist hash of this state from scratch.
+         *
+         * @return The XOR of the keys of every known fact.
+         */
+        inline FWord GetHash() const
+        {
+            FWord Hash = 0;
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                FWord Bits = Mask[W];
+                while (Bits)
+                {
+                    const int32_t Bit = CountTrailingZeros(Bits);
+                    Bits &= Bits - 1;
+                    Hash ^= GZobrist.Keys[W * 64 + Bit][(Values[W] >> Bit) & 1];
+                }
+            }
+            return Hash;
+        }
+
+        /**
+         * @brief Applies effects and updates a Zobrist hash in O(changed facts).
+         *
+         * @param Effects The facts to apply to this state.
+         * @param InOutHash The hash of this state before the call, updated to the new state.
+         */
+        inline void ApplyHashed(const FPackedState& Effects, FWord& InOutHash)
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                // Facts that were unknown or hold the other value
+                FWord Changed = Effects.Mask[W] & (~Mask[W] | (Values[W] ^ Effects.Values[W]));
+                while (Changed)
+                {
+                    const int32_t Bit = CountTrailingZeros(Changed);
+                    const FWord BitMask = 1ull << Bit;
+                    Changed &= Changed - 1;
+
+                    const FWord* Keys = GZobrist.Keys[W * 64 + Bit];
+                    if (Mask[W] & BitMask)
+                    {
+                        InOutHash ^= Keys[(Values[W] >> Bit) & 1];
+                    }
+                    InOutHash ^= Keys[(Effects.Values[W] >> Bit) & 1];
+                }
+
+                Values[W] = (Values[W] & ~Effects.Mask[W]) | Effects.Values[W];
+                Mask[W] |= Effects.Mask[W];
+            }
+        }
+
+        /**
+         * @brief Checks if any fact is known in both states with different values.
+         *
+         * @param Other The state to compare against.
+         * @return True if the two states contradict each other.
+         */
+        inline bool Conflicts(const FPackedState& Other) const
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                if (Mask[W] & Other.Mask[W] & (Values[W] ^ Other.Values[W]))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Checks if any fact is known in both states, whatever its values.
+         *
+         * @param Other The state to compare against.
+         * @return True if the two masks intersect.
+         */
+        inline bool SharesFacts(const FPackedState& Other) const
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                if (Mask[W] & Other.Mask[W])
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Adds the facts known in another state to this mask, without values.
+         *
+         * Used to build fact sets, this state's values are left untouched.
+         *
+         * @param Other The state whose mask to merge.
+         */
+        inline void AddFacts(const FPackedState& Other)
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                Mask[W] |= Other.Mask[W];
+            }
+        }
+
+        /**
+         * @brief Checks if these effects achieve at least one of the required facts.
+         *
+         * @param Requirements The partial state of open subgoals.
+         * @return True if some required fact is set to its required value by this state.
+         */
+        inline bool Achieves(const FPackedState& Requirements) const
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                if (Mask[W] & Requirements.Mask[W] & ~(Values[W] ^ Requirements.Values[W]))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Regresses this partial state (a set of requirements) through an action.
+         *
+         * Facts set by the effects are no longer required, the preconditions are required instead.
+         * The Zobrist hash is updated for the removed and added facts only. Fails without touching
+         * this state if a precondition contradicts a requirement the effects leave open.
+         *
+         * @param Effects The action's effects.
+         * @param Preconditions The action's preconditions.
+         * @param InOutHash The hash of this state before the call, updated to the new state.
+         * @return False if the regressed requirements would be inconsistent.
+         */
+        inline bool RegressHashed(const FPackedState& Effects, const FPackedState& Preconditions, FWord& InOutHash)
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                const FWord Remaining = Mask[W] & ~Effects.Mask[W];
+                if (Remaining & Preconditions.Mask[W] & (Values[W] ^ Preconditions.Values[W]))
+                {
+                    return false;
+                }
+            }
+
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                // Requirements achieved by the effects, minus those the preconditions require again unchanged
+                FWord Removed = Mask[W] & Effects.Mask[W] & ~(Preconditions.Mask[W] & ~(Values[W] ^ Preconditions.Values[W]));
+                while (Removed)
+                {
+                    const int32_t Bit = CountTrailingZeros(Removed);
+                    Removed &= Removed - 1;
+                    InOutHash ^= GZobrist.Keys[W * 64 + Bit][(Values[W] >> Bit) & 1];
+                }
+
+                const FWord Kept = Mask[W] & ~Effects.Mask[W];
+                const FWord NewValues = (Values[W] & Kept) | Preconditions.Values[W];
+                const FWord NewMask = Kept | Preconditions.Mask[W];
+
+                // Preconditions that were not already required with the same value
+                FWord Added = NewMask & ~(Mask[W] & ~(Values[W] ^ NewValues));
+                while (Added)
+                {
+                    const int32_t Bit = CountTrailingZeros(Added);
+                    Added &= Added - 1;
+                    InOutHash ^= GZobrist.Keys[W * 64 + Bit][(NewValues >> Bit) & 1];
+                }
+
+                Values[W] = NewValues;
+                Mask[W] = NewMask;
+            }
+            return true;
+        }
+
+        /** @return True if no fact is known. */
+        inline bool IsEmpty() const
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                if (Mask[W])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline bool operator==(const FPackedState& Other) const
+        {
+            for (int32_t W = 0; W < GOAP_FACT_WORDS; ++W)
+            {
+                if (Values[W] != Other.Values[W] || Mask[W] != Other.Mask[W])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline bool operator!=(const FPackedState& Other) const
+        {
+            return !(*this == Other);
+        }
+    };
+}